@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Аллокатор, выравнивающий буфер на Alignment байт (кеш-линия, регистр AVX-512)
+// через выровненный operator new. Ёмкость контейнера округляется так, чтобы
+// буфер и заканчивался на границе Alignment: векторным ядрам не нужны
+// пролог и хвостовой цикл, если они готовы обрабатывать элементы до ёмкости.
+template <typename Type, size_t Alignment = 64>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type), "Alignment must not be weaker than alignof(Type)");
+
+public:
+    using value_type = Type;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t alignment = Alignment;
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept {
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(::operator new(size * sizeof(Type), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept {
+        ::operator delete(ptr, size * sizeof(Type), std::align_val_t{Alignment});
+    }
+};
+
+template <typename Type, typename Other, size_t Alignment>
+bool operator==(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, Alignment>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other, size_t Alignment>
+bool operator!=(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, Alignment>&) noexcept {
+    return false;
+}
+
+// Выравнивание, которое гарантирует аллокатор: Allocator::alignment, если он его объявляет
+template <typename Allocator, typename = void>
+struct AllocatorAlignment
+    : std::integral_constant<size_t, alignof(typename std::allocator_traits<Allocator>::value_type)> {};
+
+template <typename Allocator>
+struct AllocatorAlignment<Allocator, std::void_t<decltype(Allocator::alignment)>>
+    : std::integral_constant<size_t, Allocator::alignment> {};
+
+// Шаг ёмкости в элементах, при котором буфер заканчивается на границе выравнивания
+template <typename Allocator>
+constexpr size_t CapacityGranularity() noexcept {
+    constexpr size_t kAlignment = AllocatorAlignment<Allocator>::value;
+    constexpr size_t kElementSize = sizeof(typename std::allocator_traits<Allocator>::value_type);
+    return kAlignment > kElementSize && kAlignment % kElementSize == 0 ? kAlignment / kElementSize : 1;
+}
+
+// Ёмкость, которую нельзя округлить без переполнения size_t, выделить всё равно
+// невозможно: как и allocate, бросает std::bad_array_new_length
+template <typename Allocator>
+constexpr size_t RoundCapacity(size_t capacity) {
+    constexpr size_t kGranularity = CapacityGranularity<Allocator>();
+    if constexpr (kGranularity == 1) {
+        return capacity;
+    } else {
+        if (capacity > std::numeric_limits<size_t>::max() - (kGranularity - 1)) {
+            throw std::bad_array_new_length();
+        }
+        return (capacity + kGranularity - 1) / kGranularity * kGranularity;
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "aligned_allocator.h"
+#include "constexpr_support.h"
+
+// Алгоритмы над неинициализированной памятью, конструирующие и разрушающие
+// элементы через std::allocator_traits. Для std::allocator, чьи construct/destroy
+// сводятся к placement new и вызову деструктора, используются стандартные
+// std::uninitialized_* (для тривиальных типов они превращаются в memmove/memset).
+
+template <typename Allocator>
+struct IsStdAllocator : std::false_type {};
+
+template <typename Type>
+struct IsStdAllocator<std::allocator<Type>> : std::true_type {};
+
+// construct/destroy не переопределены, так что он ведёт себя как std::allocator
+template <typename Type, size_t Alignment>
+struct IsStdAllocator<AlignedAllocator<Type, Alignment>> : std::true_type {};
+
+template <typename Allocator>
+inline constexpr bool kIsStdAllocator = IsStdAllocator<Allocator>::value;
+
+// Необязательное расширение аллокатора: reallocate(ptr, old_size, new_size) меняет
+// размер буфера (например, через mremap), сохраняя побайтово его начало, и
+// возвращает новый адрес. При исключении старый буфер остаётся действительным.
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Allocator>
+struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+                                    std::declval<typename std::allocator_traits<Allocator>::pointer>(),
+                                    size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Allocator>
+inline constexpr bool kHasReallocate = HasReallocate<Allocator>::value;
+
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void DestroyRange(Allocator& alloc, Type* first, Type* last) noexcept {
+    if constexpr (kIsStdAllocator<Allocator>) {
+        std::destroy(first, last);
+    } else {
+        for (; first != last; ++first) {
+            std::allocator_traits<Allocator>::destroy(alloc, first);
+        }
+    }
+}
+
+// Стандартные uninitialized_* не constexpr, поэтому при вычислении на этапе
+// компиляции элементы создаются поэлементно через allocator_traits::construct
+template <typename Allocator, typename InputIt, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedCopy(Allocator& alloc, InputIt first, InputIt last, Type* dest) {
+    if constexpr (kIsStdAllocator<Allocator>) {
+        if (!IsConstantEvaluated()) {
+            return std::uninitialized_copy(first, last, dest);
+        }
+    }
+    Type* current = dest;
+    try {
+        for (; first != last; ++first, ++current) {
+            std::allocator_traits<Allocator>::construct(alloc, current, *first);
+        }
+    } catch (...) {
+        DestroyRange(alloc, dest, current);
+        throw;
+    }
+    return current;
+}
+
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMove(Allocator& alloc, Type* first, Type* last, Type* dest) {
+    return UninitializedCopy(alloc, std::make_move_iterator(first), std::make_move_iterator(last), dest);
+}
+
+// Аналог UninitializedMove, который, как std::move_if_noexcept, копирует элементы,
+// если их перемещение может бросить исключение, а копирование возможно.
+// Так при исключении исходный диапазон остаётся нетронутым.
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMoveIfNoexcept(Allocator& alloc, Type* first, Type* last, Type* dest) {
+    if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+        return UninitializedMove(alloc, first, last, dest);
+    } else {
+        return UninitializedCopy(alloc, first, last, dest);
+    }
+}
+
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedFill(Allocator& alloc, Type* first, Type* last, const Type& value) {
+    if constexpr (kIsStdAllocator<Allocator>) {
+        if (!IsConstantEvaluated()) {
+            std::uninitialized_fill(first, last, value);
+            return;
+        }
+    }
+    Type* current = first;
+    try {
+        for (; current != last; ++current) {
+            std::allocator_traits<Allocator>::construct(alloc, current, value);
+        }
+    } catch (...) {
+        DestroyRange(alloc, first, current);
+        throw;
+    }
+}
+
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedValueConstruct(Allocator& alloc, Type* first, Type* last) {
+    if constexpr (kIsStdAllocator<Allocator>) {
+        if (!IsConstantEvaluated()) {
+            std::uninitialized_value_construct(first, last);
+            return;
+        }
+    }
+    Type* current = first;
+    try {
+        for (; current != last; ++current) {
+            std::allocator_traits<Allocator>::construct(alloc, current);
+        }
+    } catch (...) {
+        DestroyRange(alloc, first, current);
+        throw;
+    }
+}
+
+// Оставляет тривиально конструируемые элементы неинициализированными.
+// Аллокатор с собственным construct умеет только инициализацию значением,
+// поэтому для нетривиальных типов используется она. При вычислении на этапе
+// компиляции неинициализированную память читать нельзя, и элементы тоже
+// инициализируются значением.
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedDefaultConstruct(Allocator& alloc, Type* first, Type* last) {
+    if constexpr (kIsStdAllocator<Allocator> || std::is_trivially_default_constructible_v<Type>) {
+        if (!IsConstantEvaluated()) {
+            std::uninitialized_default_construct(first, last);
+            return;
+        }
+    }
+    UninitializedValueConstruct(alloc, first, last);
+}
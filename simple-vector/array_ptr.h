@@ -1,68 +1,172 @@
+#pragma once
+
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <type_traits>
 #include <utility>
+#include "aligned_allocator.h"
+#include "constexpr_support.h"
+#include "vector_stats.h"
 
-template <typename Type>
+// Владеет сырой (неинициализированной) памятью под size объектов Type,
+// выделенной аллокатором. Конструированием и разрушением элементов
+// занимается пользователь ArrayPtr. Если аллокатор выравнивает буфер сильнее
+// alignof(Type), size округляется вверх до границы выравнивания (см. RoundCapacity).
+template <typename Type, typename Allocator = std::allocator<Type>>
 class ArrayPtr {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>,
+                  "Allocator::value_type must be Type");
+
 public:
     ArrayPtr() = default;
 
-    explicit ArrayPtr(size_t size) {
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t size, const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
         if (size == 0) {
             raw_ptr_ = nullptr;
         } else {
-            raw_ptr_ = new Type[size];
+            size_ = RoundCapacity<Allocator>(size);
+            raw_ptr_ = AllocTraits::allocate(alloc_, size_);
+            VectorStatsHooks<Type>::OnAllocation(size_);
         }
     }
 
-    ArrayPtr(ArrayPtr&& other) noexcept : raw_ptr_(std::exchange(other.raw_ptr_, nullptr)) {}
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(ArrayPtr&& other) noexcept
+        : alloc_(std::move(other.alloc_)),
+          raw_ptr_(std::exchange(other.raw_ptr_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {
+    }
 
-    ArrayPtr& operator=(ArrayPtr&& other) noexcept {
+    // Аллокатор перенимается, только если это разрешает propagate_on_container_move_assignment.
+    // Иначе аллокаторы обязаны быть равны: за этим следит вызывающая сторона.
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& other) noexcept {
         if (this != &other) {
-            delete[] raw_ptr_;
+            Deallocate();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(other.alloc_);
+            } else {
+                assert(alloc_ == other.alloc_);
+            }
             raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+            size_ = std::exchange(other.size_, 0);
         }
         return *this;
     }
 
-    explicit ArrayPtr(Type* raw_ptr) noexcept : raw_ptr_(raw_ptr) {}
+    // raw_ptr должен быть выделен аллокатором, равным alloc, ровно под size элементов
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc = Allocator()) noexcept
+        : alloc_(alloc),
+          raw_ptr_(raw_ptr),
+          size_(raw_ptr ? size : 0) {
+    }
 
     ArrayPtr(const ArrayPtr&) = delete;
 
-    ~ArrayPtr() {
-        delete[] raw_ptr_;
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr() {
+        Deallocate();
     }
 
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    [[nodiscard]] Type* Release() noexcept {
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR Type* Release() noexcept {
         Type* old_ptr = raw_ptr_;
         raw_ptr_ = nullptr;
+        size_ = 0;
         return old_ptr;
     }
 
-    Type& operator[](size_t index) noexcept {
+    // Освобождает память и принимает буфер raw_ptr, выделенный alloc под size элементов.
+    // Аллокатор заменяется, только если это разрешает propagate_on_container_move_assignment
+    // или propagate_on_container_copy_assignment (у pmr::polymorphic_allocator присваивания нет).
+    // Иначе alloc обязан быть равен GetAllocator().
+    SIMPLE_VECTOR_CONSTEXPR void Reset(Type* raw_ptr, size_t size, const Allocator& alloc) {
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value ||
+                      AllocTraits::propagate_on_container_copy_assignment::value) {
+            Deallocate();
+            alloc_ = alloc;
+        } else {
+            assert(alloc_ == alloc);
+            Deallocate();
+        }
+        raw_ptr_ = raw_ptr;
+        size_ = raw_ptr ? size : 0;
+    }
+
+    // Меняет размер буфера через Allocator::reallocate (см. kHasReallocate), сохраняя
+    // побайтово начало. Пригодно только для тривиально переносимых Type.
+    void Reallocate(size_t size) {
+        assert(raw_ptr_ && size != 0);
+        const size_t new_size = RoundCapacity<Allocator>(size);
+        raw_ptr_ = alloc_.reallocate(raw_ptr_, size_, new_size);
+        size_ = new_size;
+        VectorStatsHooks<Type>::OnAllocation(new_size);
+    }
+
+    // Освобождает память и заменяет аллокатор
+    SIMPLE_VECTOR_CONSTEXPR void Reset(const Allocator& alloc) {
+        Deallocate();
+        raw_ptr_ = nullptr;
+        size_ = 0;
+        alloc_ = alloc;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
         assert(raw_ptr_);
         return raw_ptr_[index];
     }
 
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
         assert(raw_ptr_);
         return raw_ptr_[index];
     }
 
-    explicit operator bool() const {
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const {
         return raw_ptr_;
     }
 
-    Type* Get() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type* Get() const noexcept {
         return raw_ptr_;
     }
 
-    void swap(ArrayPtr& other) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Allocator& GetAllocator() noexcept {
+        return alloc_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Allocator& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Аллокаторы обмениваются, только если это разрешает propagate_on_container_swap
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(size_, other.size_);
     }
 
 private:
+    SIMPLE_VECTOR_CONSTEXPR void Deallocate() noexcept {
+        if (raw_ptr_) {
+            AllocTraits::deallocate(alloc_, raw_ptr_, size_);
+        }
+    }
+
+    Allocator alloc_;
     Type* raw_ptr_ = nullptr;
+    size_t size_ = 0;
 };
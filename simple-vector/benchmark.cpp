@@ -0,0 +1,660 @@
+// Сравнение SimpleVector с std::vector на Google Benchmark.
+// Сборка: g++ -std=c++17 -O2 -DNDEBUG benchmark.cpp -lbenchmark -lpthread -o benchmark
+// Цена проверок границ: та же сборка с -DSIMPLE_VECTOR_CHECKS=1 (Hardened)
+#include "flat_map.h"
+#include "huge_page_allocator.h"
+#include "parallel_algorithms.h"
+#include "segmented_simple_vector.h"
+#include "simple_deque.h"
+#include "simple_vector.h"
+#include "soa_simple_vector.h"
+#include "streaming_algorithms.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+struct Pod64 {
+    uint64_t fields[8];
+
+    bool operator==(const Pod64& other) const {
+        for (size_t i = 0; i < 8; ++i) {
+            if (fields[i] != other.fields[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool operator<(const Pod64& other) const {
+        for (size_t i = 0; i < 8; ++i) {
+            if (fields[i] != other.fields[i]) {
+                return fields[i] < other.fields[i];
+            }
+        }
+        return false;
+    }
+};
+
+static_assert(sizeof(Pod64) == 64);
+
+// Некопируемый тип из тестов main.cpp
+class X {
+public:
+    X()
+        : X(5) {
+    }
+    X(size_t num)
+        : x_(num) {
+    }
+    X(const X& other) = delete;
+    X& operator=(const X& other) = delete;
+    X(X&& other) {
+        x_ = exchange(other.x_, 0);
+    }
+    X& operator=(X&& other) {
+        x_ = exchange(other.x_, 0);
+        return *this;
+    }
+    size_t GetX() const {
+        return x_;
+    }
+
+private:
+    size_t x_;
+};
+
+template <typename Type>
+Type MakeValue(size_t i) {
+    if constexpr (is_same_v<Type, int>) {
+        return static_cast<int>(i);
+    } else if constexpr (is_same_v<Type, Pod64>) {
+        return Pod64{{i, i, i, i, i, i, i, i}};
+    } else if constexpr (is_same_v<Type, string>) {
+        // длиннее SSO-буфера, чтобы строка жила в куче
+        return "benchmark string value #"s + to_string(i);
+    } else {
+        return Type(i);
+    }
+}
+
+// Единый интерфейс к std::vector и SimpleVector
+
+template <typename Container>
+struct ElementOf;
+
+template <typename Type>
+struct ElementOf<vector<Type>> {
+    using type = Type;
+};
+
+template <typename Type>
+struct ElementOf<SimpleVector<Type>> {
+    using type = Type;
+};
+
+template <typename Type>
+struct ElementOf<SegmentedSimpleVector<Type>> {
+    using type = Type;
+};
+
+template <typename Container>
+using Element = typename ElementOf<Container>::type;
+
+template <typename Type>
+void PushBack(vector<Type>& v, Type&& value) {
+    v.push_back(std::move(value));
+}
+
+template <typename Type>
+void PushBack(SimpleVector<Type>& v, Type&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename Type>
+void PushBack(SegmentedSimpleVector<Type>& v, Type&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename Type>
+void Reserve(vector<Type>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename Type>
+void Reserve(SimpleVector<Type>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename Type>
+void Reserve(SegmentedSimpleVector<Type>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename Type>
+void InsertAt(vector<Type>& v, size_t index, Type&& value) {
+    v.insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void InsertAt(SimpleVector<Type>& v, size_t index, Type&& value) {
+    v.Insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void EraseAt(vector<Type>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+
+template <typename Type>
+void EraseAt(SimpleVector<Type>& v, size_t index) {
+    v.Erase(v.begin() + index);
+}
+
+template <typename Type>
+void Resize(vector<Type>& v, size_t size) {
+    v.resize(size);
+}
+
+template <typename Type>
+void Resize(SimpleVector<Type>& v, size_t size) {
+    v.Resize(size);
+}
+
+template <typename Type>
+size_t Size(const vector<Type>& v) {
+    return v.size();
+}
+
+template <typename Type>
+size_t Size(const SimpleVector<Type>& v) {
+    return v.GetSize();
+}
+
+template <typename Type>
+const Type* FindValue(const vector<Type>& v, const Type& value) {
+    return &*find(v.begin(), v.end(), value);
+}
+
+template <typename Type>
+const Type* FindValue(const SimpleVector<Type>& v, const Type& value) {
+    return v.Find(value);
+}
+
+template <typename Container>
+Container MakeContainer(size_t size) {
+    Container c;
+    Reserve(c, size);
+    for (size_t i = 0; i < size; ++i) {
+        PushBack(c, MakeValue<Element<Container>>(i));
+    }
+    return c;
+}
+
+enum Position : int64_t { kFront, kMiddle, kBack };
+
+size_t IndexFor(int64_t position, size_t size) {
+    switch (position) {
+        case kFront:
+            return 0;
+        case kMiddle:
+            return size / 2;
+        default:
+            return size;
+    }
+}
+
+constexpr size_t kBatch = 64;
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const bool reserved = state.range(1) != 0;
+    for (auto _ : state) {
+        Container c;
+        if (reserved) {
+            Reserve(c, size);
+        }
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(c, MakeValue<Element<Container>>(i));
+        }
+        benchmark::DoNotOptimize(&c);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_Insert(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container c = MakeContainer<Container>(size);
+        state.ResumeTiming();
+        for (size_t i = 0; i < kBatch; ++i) {
+            InsertAt(c, IndexFor(state.range(1), Size(c)), MakeValue<Element<Container>>(i));
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+template <typename Container>
+void BM_Erase(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container c = MakeContainer<Container>(size + kBatch);
+        state.ResumeTiming();
+        for (size_t i = 0; i < kBatch; ++i) {
+            const size_t index = IndexFor(state.range(1), Size(c));
+            EraseAt(c, index == Size(c) ? index - 1 : index);
+        }
+        benchmark::DoNotOptimize(&c);
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+template <typename Container>
+void BM_CopyConstruct(benchmark::State& state) {
+    const Container source = MakeContainer<Container>(state.range(0));
+    for (auto _ : state) {
+        Container copy(source);
+        benchmark::DoNotOptimize(&copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_MoveConstruct(benchmark::State& state) {
+    Container source = MakeContainer<Container>(state.range(0));
+    for (auto _ : state) {
+        Container moved(std::move(source));
+        benchmark::DoNotOptimize(&moved);
+        source = std::move(moved);
+    }
+}
+
+template <typename Container>
+void BM_Equal(benchmark::State& state) {
+    const Container lhs = MakeContainer<Container>(state.range(0));
+    const Container rhs = MakeContainer<Container>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_Less(benchmark::State& state) {
+    const Container lhs = MakeContainer<Container>(state.range(0));
+    const Container rhs = MakeContainer<Container>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs < rhs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Ищется значение последнего элемента: просматривается весь вектор
+template <typename Container>
+void BM_Find(benchmark::State& state) {
+    const Container c = MakeContainer<Container>(state.range(0));
+    const auto value = MakeValue<Element<Container>>(state.range(0) - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FindValue(c, value));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_Resize(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Container c;
+        Resize(c, size);
+        benchmark::DoNotOptimize(&c);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Частица из девяти полей, цикл читает два из них
+struct Particle {
+    double x, y, z, vx, vy, vz, mass, charge;
+    int id;
+};
+
+void BM_ScanParticlesAoS(benchmark::State& state) {
+    const size_t size = state.range(0);
+    SimpleVector<Particle> particles(size);
+    for (size_t i = 0; i < size; ++i) {
+        particles[i].x = static_cast<double>(i);
+        particles[i].vx = 1.0;
+    }
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const Particle& particle : particles) {
+            sum += particle.x * particle.vx;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void BM_ScanParticlesSoA(benchmark::State& state) {
+    const size_t size = state.range(0);
+    SoASimpleVector<double, double, double, double, double, double, double, double, int> particles(size);
+    for (size_t i = 0; i < size; ++i) {
+        get<0>(particles[i]) = static_cast<double>(i);
+        get<3>(particles[i]) = 1.0;
+    }
+    for (auto _ : state) {
+        const double* x = particles.Column<0>().begin();
+        const double* vx = particles.Column<3>().begin();
+        double sum = 0.0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += x[i] * vx[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+int LookupValue(const map<int, int>& m, int key) {
+    return m.find(key)->second;
+}
+
+int LookupValue(const FlatMap<int, int>& m, int key) {
+    return m.Find(key)->second;
+}
+
+// Поиск всех ключей таблицы по очереди с шагом, ломающим последовательный доступ
+template <typename Map>
+void BM_Lookup(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Map map;
+    for (int i = 0; i < size; ++i) {
+        map[i * 2] = i;
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (int i = 0; i < size; ++i) {
+            sum += LookupValue(map, (i * 7919 % size) * 2);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void LookupSizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(8, 1 << 15);
+}
+
+// Очередь FIFO постоянной длины: на каждом шаге снимается голова и добавляется хвост
+void BM_FifoSimpleVector(benchmark::State& state) {
+    const size_t size = state.range(0);
+    SimpleVector<int> queue;
+    for (size_t i = 0; i < size; ++i) {
+        queue.PushBack(static_cast<int>(i));
+    }
+    for (auto _ : state) {
+        const int head = queue[0];
+        queue.Erase(queue.begin());
+        queue.PushBack(head);
+        benchmark::DoNotOptimize(queue.begin());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FifoSimpleDeque(benchmark::State& state) {
+    const size_t size = state.range(0);
+    SimpleDeque<int> queue;
+    for (size_t i = 0; i < size; ++i) {
+        queue.PushBack(static_cast<int>(i));
+    }
+    for (auto _ : state) {
+        const int head = queue[0];
+        queue.PopFront();
+        queue.PushBack(head);
+        benchmark::DoNotOptimize(&queue[0]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Чтение через operator[] по заранее вычисленным индексам: проверка границ
+// остаётся в цикле на каждом обращении, поэтому здесь видна её полная цена
+template <typename Vector>
+void BM_IndexedSum(benchmark::State& state) {
+    const size_t size = state.range(0);
+    Vector v;
+    vector<size_t> indices;
+    for (size_t i = 0; i < size; ++i) {
+        PushBack(v, static_cast<int>(i));
+        indices.push_back(i * 7919 % size);
+    }
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t index : indices) {
+            sum += v[index];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Рост большого буфера без Reserve: std::allocator копирует элементы на каждом
+// удвоении, HugePageAllocator расширяет отображение mremap
+template <typename Vector>
+void BM_GrowLarge(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Vector v;
+        for (size_t i = 0; i < size; ++i) {
+            v.PushBack(static_cast<float>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Случайное чтение из буфера больше, чем покрывает TLB обычных страниц
+template <typename Vector>
+void BM_RandomReadLarge(benchmark::State& state) {
+    const size_t size = state.range(0);
+    Vector v;
+    v.Resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<float>(i);
+    }
+    uint64_t index = 0;
+    for (auto _ : state) {
+        float sum = 0;
+        for (int i = 0; i < 1024; ++i) {
+            index = (index * 6364136223846793005u + 1442695040888963407u);
+            sum += v[(index >> 20) % size];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+// Заполнение и копирование буфера float разными путями. Размер задан в байтах;
+// пересечение кривых обычных и потоковых записей даёт порог kStreamingThreshold,
+// а параллельных — kParallelStreamingThreshold
+void BM_FillStd(benchmark::State& state) {
+    SimpleVector<float> v(state.range(0) / sizeof(float));
+    for (auto _ : state) {
+        std::fill(v.begin(), v.end(), 1.5f);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_FillStreaming(benchmark::State& state) {
+    SimpleVector<float> v(state.range(0) / sizeof(float));
+    for (auto _ : state) {
+        StreamingFill(v.begin(), v.GetSize(), 1.5f);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Путь с выбором по порогам, которым пользуется SimpleVector::Assign
+void BM_Assign(benchmark::State& state) {
+    SimpleVector<float> v(state.range(0) / sizeof(float));
+    for (auto _ : state) {
+        v.Assign(v.GetSize(), 1.5f);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ParallelFill(benchmark::State& state) {
+    SimpleVector<float> v(state.range(0) / sizeof(float));
+    for (auto _ : state) {
+        ParallelChunks(v.begin(), v.end(), {}, [](size_t, float* first, float* last) {
+            StreamingFill(first, static_cast<size_t>(last - first), 1.5f);
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CopyStd(benchmark::State& state) {
+    const SimpleVector<float> source(state.range(0) / sizeof(float), 1.5f);
+    SimpleVector<float> dest(source.GetSize());
+    for (auto _ : state) {
+        std::copy(source.begin(), source.end(), dest.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CopyStreaming(benchmark::State& state) {
+    const SimpleVector<float> source(state.range(0) / sizeof(float), 1.5f);
+    SimpleVector<float> dest(source.GetSize());
+    for (auto _ : state) {
+        StreamingCopy(source.begin(), source.GetSize(), dest.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ParallelCopy(benchmark::State& state) {
+    const SimpleVector<float> source(state.range(0) / sizeof(float), 1.5f);
+    SimpleVector<float> dest(source.GetSize());
+    for (auto _ : state) {
+        ParallelChunks(dest.begin(), dest.end(), {}, [&](size_t, float* first, float* last) {
+            StreamingCopy(source.begin() + (first - dest.begin()), static_cast<size_t>(last - first), first);
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void ByteSizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(1 << 18, 1 << 30)->Unit(benchmark::kMicrosecond);
+}
+
+void LargeSizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(1 << 20, 1 << 26)->Unit(benchmark::kMillisecond);
+}
+
+void Sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(16, 1 << 20);
+}
+
+void PushBackArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t size : {16, 1 << 10, 1 << 16, 1 << 20}) {
+        b->Args({size, 0})->Args({size, 1});
+    }
+    b->ArgNames({"size", "reserved"});
+}
+
+void ShiftArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t size : {16, 1 << 10, 1 << 14}) {
+        for (int64_t position : {kFront, kMiddle, kBack}) {
+            b->Args({size, position});
+        }
+    }
+    b->ArgNames({"size", "position"});
+}
+
+}  // namespace
+
+// Каждый сценарий запускается для std::vector (базовая линия) и SimpleVector
+#define BENCHMARK_BOTH(func, Type, apply)                         \
+    BENCHMARK_TEMPLATE(func, vector<Type>)->Apply(apply);         \
+    BENCHMARK_TEMPLATE(func, SimpleVector<Type>)->Apply(apply)
+
+#define BENCHMARK_ALL_TYPES(func, apply)   \
+    BENCHMARK_BOTH(func, int, apply);      \
+    BENCHMARK_BOTH(func, Pod64, apply);    \
+    BENCHMARK_BOTH(func, string, apply);   \
+    BENCHMARK_BOTH(func, X, apply)
+
+// X некопируем и не сравнивается
+#define BENCHMARK_COPYABLE_TYPES(func, apply) \
+    BENCHMARK_BOTH(func, int, apply);         \
+    BENCHMARK_BOTH(func, Pod64, apply);       \
+    BENCHMARK_BOTH(func, string, apply)
+
+BENCHMARK_ALL_TYPES(BM_PushBack, PushBackArgs);
+BENCHMARK_ALL_TYPES(BM_Insert, ShiftArgs);
+BENCHMARK_ALL_TYPES(BM_Erase, ShiftArgs);
+BENCHMARK_COPYABLE_TYPES(BM_CopyConstruct, Sizes);
+BENCHMARK_ALL_TYPES(BM_MoveConstruct, Sizes);
+BENCHMARK_COPYABLE_TYPES(BM_Equal, Sizes);
+BENCHMARK_COPYABLE_TYPES(BM_Less, Sizes);
+BENCHMARK_ALL_TYPES(BM_Resize, Sizes);
+
+// Векторизованные сравнения и поиск для арифметических типов
+BENCHMARK_BOTH(BM_Equal, uint8_t, Sizes);
+BENCHMARK_BOTH(BM_Less, uint8_t, Sizes);
+BENCHMARK_BOTH(BM_Less, double, Sizes);
+BENCHMARK_BOTH(BM_Find, int, Sizes);
+BENCHMARK_BOTH(BM_Find, double, Sizes);
+
+// Упорядоченный поиск: узловое дерево против непрерывного FlatMap
+BENCHMARK_TEMPLATE(BM_Lookup, map<int, int>)->Apply(LookupSizes);
+BENCHMARK_TEMPLATE(BM_Lookup, FlatMap<int, int>)->Apply(LookupSizes);
+
+// Обход двух полей из девяти: массив структур против структуры массивов
+BENCHMARK(BM_ScanParticlesAoS)->Apply(Sizes);
+BENCHMARK(BM_ScanParticlesSoA)->Apply(Sizes);
+
+// Очередь: сдвиг всего вектора против кольцевого буфера
+BENCHMARK(BM_FifoSimpleVector)->Apply(Sizes);
+BENCHMARK(BM_FifoSimpleDeque)->Apply(Sizes);
+
+// Доступ по индексу; с SIMPLE_VECTOR_CHECKS=1 — вместе с проверкой границ
+BENCHMARK_BOTH(BM_IndexedSum, int, Sizes);
+
+// Буферы в сотни мегабайт: обычная куча против huge pages и mremap
+BENCHMARK_TEMPLATE(BM_GrowLarge, SimpleVector<float>)->Apply(LargeSizes);
+BENCHMARK_TEMPLATE(BM_GrowLarge, HugePageSimpleVector<float>)->Apply(LargeSizes);
+BENCHMARK_TEMPLATE(BM_RandomReadLarge, SimpleVector<float>)->Apply(LargeSizes)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(BM_RandomReadLarge, HugePageSimpleVector<float>)->Apply(LargeSizes)->Unit(benchmark::kNanosecond);
+
+// Обычные, потоковые и параллельные потоковые записи
+BENCHMARK(BM_FillStd)->Apply(ByteSizes);
+BENCHMARK(BM_FillStreaming)->Apply(ByteSizes);
+BENCHMARK(BM_Assign)->Apply(ByteSizes);
+BENCHMARK(BM_ParallelFill)->Apply(ByteSizes);
+BENCHMARK(BM_CopyStd)->Apply(ByteSizes);
+BENCHMARK(BM_CopyStreaming)->Apply(ByteSizes);
+BENCHMARK(BM_ParallelCopy)->Apply(ByteSizes);
+
+// Рост сегментами без перемещения элементов
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedSimpleVector<int>)->Apply(PushBackArgs);
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedSimpleVector<Pod64>)->Apply(PushBackArgs);
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedSimpleVector<string>)->Apply(PushBackArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <type_traits>
+#include "constexpr_support.h"
+
+// Режим проверок на горячих путях контейнеров (operator[], Insert, Erase, PopBack).
+// Действует на все контейнеры библиотеки и на SimpleVectorView; внутренние
+// инварианты реализации по-прежнему проверяет assert.
+// Задаётся макросом SIMPLE_VECTOR_CHECKS, одинаковым во всех единицах трансляции:
+//   0 — Unchecked: проверок нет, нарушение предусловия — неопределённое поведение;
+//   1 — Hardened: дешёвые проверки границ, при нарушении программа останавливается
+//       инструкцией trap без вывода и без исключений (годится и для обработчиков сигналов);
+//   2 — Debug: проверки Hardened и дорогие проверки итераторов, перед остановкой
+//       в stderr выводится, какое условие нарушено.
+// По умолчанию, как прежде с assert: Debug в отладочной сборке и Unchecked с NDEBUG.
+// At по-прежнему бросает std::out_of_range в любом режиме.
+#ifndef SIMPLE_VECTOR_CHECKS
+#ifdef NDEBUG
+#define SIMPLE_VECTOR_CHECKS 0
+#else
+#define SIMPLE_VECTOR_CHECKS 2
+#endif
+#endif
+
+enum class CheckMode {
+    Unchecked = 0,
+    Hardened = 1,
+    Debug = 2,
+};
+
+inline constexpr CheckMode kCheckMode = static_cast<CheckMode>(SIMPLE_VECTOR_CHECKS);
+
+static_assert(kCheckMode == CheckMode::Unchecked || kCheckMode == CheckMode::Hardened ||
+                  kCheckMode == CheckMode::Debug,
+              "SIMPLE_VECTOR_CHECKS must be 0, 1 or 2");
+
+// Вынесена из горячего пути: в месте проверки остаются сравнение и переход
+[[noreturn, gnu::cold, gnu::noinline]] inline void CheckFailed(const char* condition) noexcept {
+    if constexpr (kCheckMode == CheckMode::Debug) {
+        std::fprintf(stderr, "SimpleVector check failed: %s\n", condition);
+        std::abort();
+    } else {
+        static_cast<void>(condition);
+        __builtin_trap();
+    }
+}
+
+// Проверка режимов Hardened и Debug. При вычислении на этапе компиляции
+// нарушение делает выражение неконстантным, то есть становится ошибкой компиляции.
+constexpr void HardenedCheck(bool condition, const char* description) noexcept {
+    if constexpr (kCheckMode != CheckMode::Unchecked) {
+        if (!condition) [[unlikely]] {
+            CheckFailed(description);
+        }
+    } else {
+        static_cast<void>(condition);
+        static_cast<void>(description);
+    }
+}
+
+// Проверка только режима Debug: её условие не вычисляется в остальных режимах,
+// поэтому передаётся функцией
+template <typename Predicate>
+constexpr void DebugCheck(Predicate condition, const char* description) noexcept {
+    if constexpr (kCheckMode == CheckMode::Debug) {
+        if (!condition()) [[unlikely]] {
+            CheckFailed(description);
+        }
+    } else {
+        static_cast<void>(condition);
+        static_cast<void>(description);
+    }
+}
+
+// Указывает ли ptr внутрь [first, last). std::less задаёт порядок и для указателей
+// на разные массивы; на этапе компиляции такое сравнение недоступно,
+// и проверка считается пройденной.
+template <typename Type>
+constexpr bool PointsInto(const Type* ptr, const Type* first, const Type* last) noexcept {
+    if (IsConstantEvaluated()) {
+        return false;
+    }
+    return !std::less<const Type*>()(ptr, first) && std::less<const Type*>()(ptr, last);
+}
+
+// Debug: вставляемый диапазон-указатели упорядочен и не лежит внутри контейнера
+// [begin, end), ведь сдвиг элементов испортил бы его до копирования
+template <typename Type, typename InputIt>
+constexpr void DebugCheckForeignRange(InputIt first, InputIt last, const Type* begin, const Type* end) noexcept {
+    if constexpr (std::is_pointer_v<InputIt> &&
+                  std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, Type>) {
+        DebugCheck(
+            [&] {
+                return !std::less<const Type*>()(last, first);
+            },
+            "source range is ordered");
+        DebugCheck(
+            [&] {
+                return first == last || !PointsInto<Type>(first, begin, end);
+            },
+            "source range does not alias the container");
+    } else {
+        static_cast<void>(first);
+        static_cast<void>(last);
+        static_cast<void>(begin);
+        static_cast<void>(end);
+    }
+}
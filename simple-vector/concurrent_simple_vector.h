@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include "array_ptr.h"
+#include "bounds_check.h"
+#include "simple_vector.h"
+
+// Вектор только для добавления, в который PushBack/EmplaceBack можно вызывать
+// из многих потоков без блокировок: индекс резервируется атомарным счётчиком,
+// а элементы живут в сегментах удваивающегося размера, которые никогда не
+// перемещаются, так что ссылки на элементы остаются действительными.
+// Элемент с индексом i опубликован, когда конструктор завершился: это
+// проверяет IsPublished, а operator[] для опубликованного индекса wait-free.
+// Без блокировок работает сам алгоритм; выделение сегмента идёт через operator new.
+template <typename Type, size_t FirstSegmentSize = 64>
+class ConcurrentSimpleVector {
+    static_assert(FirstSegmentSize != 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+                  "FirstSegmentSize must be a power of two");
+
+public:
+    ConcurrentSimpleVector() noexcept = default;
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        Clear();
+    }
+
+    // Возвращает индекс добавленного элемента
+    size_t PushBack(const Type& item) {
+        return EmplaceBack(item);
+    }
+
+    size_t PushBack(Type&& item) {
+        return EmplaceBack(std::move(item));
+    }
+
+    // Если конструктор бросает исключение, зарезервированный индекс остаётся
+    // неопубликованным навсегда, а Freeze его пропускает
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        const Location location = Locate(index);
+        Segment& segment = AcquireSegment(location.segment);
+        try {
+            new (segment.items.Get() + location.offset) Type(std::forward<Args>(args)...);
+        } catch (...) {
+            segment.states[location.offset].store(kFailed, std::memory_order_release);
+            throw;
+        }
+        segment.states[location.offset].store(kPublished, std::memory_order_release);
+        return index;
+    }
+
+    // Число зарезервированных индексов, включая ещё не опубликованные
+    size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // acquire: если true, содержимое элемента видно вызывающему потоку
+    bool IsPublished(size_t index) const noexcept {
+        if (index >= GetSize()) {
+            return false;
+        }
+        const Location location = Locate(index);
+        const Segment* segment = segments_[location.segment].load(std::memory_order_acquire);
+        return segment && segment->states[location.offset].load(std::memory_order_acquire) == kPublished;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        DebugCheck(
+            [&] {
+                return IsPublished(index);
+            },
+            "element is published");
+        const Location location = Locate(index);
+        return segments_[location.segment].load(std::memory_order_acquire)->items[location.offset];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        DebugCheck(
+            [&] {
+                return IsPublished(index);
+            },
+            "element is published");
+        const Location location = Locate(index);
+        return segments_[location.segment].load(std::memory_order_acquire)->items[location.offset];
+    }
+
+    // Переносит опубликованные элементы по порядку индексов в непрерывный
+    // SimpleVector и опустошает контейнер. Нельзя вызывать одновременно с добавлением.
+    SimpleVector<Type> Freeze() {
+        SimpleVector<Type> result(Reserve(GetSize()));
+        ForEachPublished([&result](Type& item) {
+            result.PushBack(std::move_if_noexcept(item));
+        });
+        Clear();
+        return result;
+    }
+
+    // Разрушает элементы и освобождает сегменты. Нельзя вызывать одновременно с добавлением.
+    void Clear() noexcept {
+        ForEachPublished([](Type& item) {
+            item.~Type();
+        });
+        for (std::atomic<Segment*>& segment : segments_) {
+            delete segment.exchange(nullptr, std::memory_order_acq_rel);
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+private:
+    static constexpr uint8_t kPublished = 1;
+    static constexpr uint8_t kFailed = 2;
+
+    // Сегмент k вмещает FirstSegmentSize << k элементов. Locate возвращает номер
+    // сегмента не больше 63 - log2(FirstSegmentSize): с FirstSegmentSize = 64
+    // индекс size_t занимает до 58 сегментов
+    static constexpr size_t kMaxSegments =
+        std::numeric_limits<size_t>::digits - static_cast<size_t>(__builtin_ctzll(FirstSegmentSize));
+
+    struct Segment {
+        explicit Segment(size_t size)
+            : items(size),
+              states(new std::atomic<uint8_t>[size]()) {
+        }
+
+        ArrayPtr<Type> items;
+        std::unique_ptr<std::atomic<uint8_t>[]> states;
+    };
+
+    struct Location {
+        size_t segment;
+        size_t offset;
+    };
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return FirstSegmentSize << segment;
+    }
+
+    // Сегменты 0..k-1 вмещают FirstSegmentSize * (2^k - 1) элементов
+    static Location Locate(size_t index) noexcept {
+        const size_t block = index / FirstSegmentSize + 1;
+        const size_t segment = static_cast<size_t>(63 - __builtin_clzll(block));
+        return {segment, index - FirstSegmentSize * ((size_t{1} << segment) - 1)};
+    }
+
+    // Первый обратившийся поток выделяет сегмент; проигравшие гонку освобождают свой
+    Segment& AcquireSegment(size_t index) {
+        HardenedCheck(index < kMaxSegments, "segment index < kMaxSegments");
+        Segment* segment = segments_[index].load(std::memory_order_acquire);
+        if (!segment) {
+            auto fresh = std::make_unique<Segment>(SegmentSize(index));
+            if (segments_[index].compare_exchange_strong(segment, fresh.get(), std::memory_order_acq_rel,
+                                                         std::memory_order_acquire)) {
+                segment = fresh.release();
+            }
+        }
+        return *segment;
+    }
+
+    template <typename Function>
+    void ForEachPublished(Function function) {
+        const size_t size = GetSize();
+        for (size_t index = 0; index < size; ++index) {
+            const Location location = Locate(index);
+            Segment* segment = segments_[location.segment].load(std::memory_order_acquire);
+            if (segment && segment->states[location.offset].load(std::memory_order_acquire) == kPublished) {
+                function(segment->items[location.offset]);
+            }
+        }
+    }
+
+    std::atomic<size_t> size_{0};
+    std::atomic<Segment*> segments_[kMaxSegments] = {};
+};
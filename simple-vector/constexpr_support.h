@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// В C++20 контейнеры работают и при вычислении на этапе компиляции:
+// память, выделенная std::allocator, должна освободиться до конца вычисления.
+// В C++17 макрос пустой, и код остаётся прежним.
+#if __cplusplus >= 202002L
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#else
+#define SIMPLE_VECTOR_CONSTEXPR
+#endif
+
+// Пути с memcpy, memmove и векторными ядрами недоступны при вычислении
+// на этапе компиляции, поэтому там они заменяются поэлементными циклами
+constexpr bool IsConstantEvaluated() noexcept {
+#if __cplusplus >= 202002L
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Placement new, допустимый при вычислении на этапе компиляции (std::construct_at)
+template <typename Type, typename... Args>
+SIMPLE_VECTOR_CONSTEXPR Type* ConstructAt(Type* ptr, Args&&... args) {
+#if __cplusplus >= 202002L
+    return std::construct_at(ptr, std::forward<Args>(args)...);
+#else
+    return ::new (static_cast<void*>(ptr)) Type(std::forward<Args>(args)...);
+#endif
+}
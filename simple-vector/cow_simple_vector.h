@@ -0,0 +1,315 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "bounds_check.h"
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+// Вектор с копированием при записи: копии за O(1) разделяют один буфер
+// с атомарным счётчиком ссылок, а первая изменяющая операция над разделённым
+// буфером копирует его. Копии можно передавать между потоками; сам объект
+// CowSimpleVector, как и SimpleVector, одновременно менять нельзя.
+// Неконстантные ссылки и итераторы нельзя хранить через копирование вектора:
+// записи через них увидела бы и копия.
+template <typename Type, typename Allocator = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth>
+class CowSimpleVector {
+public:
+    using Vector = SimpleVector<Type, Allocator, GrowthPolicy>;
+    using Iterator = typename Vector::Iterator;
+    using ConstIterator = typename Vector::ConstIterator;
+    using allocator_type = Allocator;
+
+    CowSimpleVector() noexcept = default;
+
+    // Забирает элементы vector без копирования
+    CowSimpleVector(Vector&& vector)
+        : shared_(new Shared(std::move(vector))) {
+    }
+
+    explicit CowSimpleVector(size_t size)
+        : CowSimpleVector(Vector(size)) {
+    }
+
+    CowSimpleVector(size_t size, const Type& value)
+        : CowSimpleVector(Vector(size, value)) {
+    }
+
+    CowSimpleVector(std::initializer_list<Type> init)
+        : CowSimpleVector(Vector(init)) {
+    }
+
+    CowSimpleVector(const CowSimpleVector& other) noexcept
+        : shared_(other.shared_) {
+        if (shared_) {
+            shared_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowSimpleVector(CowSimpleVector&& other) noexcept
+        : shared_(std::exchange(other.shared_, nullptr)) {
+    }
+
+    CowSimpleVector& operator=(const CowSimpleVector& rhs) noexcept {
+        CowSimpleVector(rhs).swap(*this);
+        return *this;
+    }
+
+    CowSimpleVector& operator=(CowSimpleVector&& rhs) noexcept {
+        CowSimpleVector(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~CowSimpleVector() {
+        Unshare();
+    }
+
+    // Содержимое только для чтения; копирования не вызывает
+    const Vector& GetVector() const noexcept {
+        return shared_ ? shared_->items : Empty();
+    }
+
+    // Доступ к изменяемому вектору: разделённый буфер сначала копируется
+    Vector& Mutable() {
+        if (!shared_) {
+            shared_ = new Shared(Vector());
+        } else if (IsShared()) {
+            Shared* copy = new Shared(Vector(shared_->items));
+            Unshare();
+            shared_ = copy;
+        }
+        return shared_->items;
+    }
+
+    // Буфер разделён с другими копиями
+    bool IsShared() const noexcept {
+        // acquire: записи прежних владельцев видны до того, как буфер начнут менять
+        return shared_ && shared_->refs.load(std::memory_order_acquire) > 1;
+    }
+
+    size_t GetSize() const noexcept {
+        return GetVector().GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return GetVector().GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetVector().IsEmpty();
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return GetVector().GetAllocator();
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return GetVector()[index];
+    }
+
+    Type& operator[](size_t index) {
+        return Mutable()[index];
+    }
+
+    const Type& At(size_t index) const {
+        return GetVector().At(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return Mutable()[index];
+    }
+
+    ConstIterator Find(const Type& value) const {
+        return GetVector().Find(value);
+    }
+
+    bool Contains(const Type& value) const {
+        return GetVector().Contains(value);
+    }
+
+    size_t Count(const Type& value) const {
+        return GetVector().Count(value);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Mutable().Reserve(new_capacity);
+        }
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size != GetSize()) {
+            Mutable().Resize(new_size);
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Аргументы могут ссылаться на элемент разделённого буфера: он отпускается
+    // только после операции
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        CowSimpleVector previous;
+        return MutableKeeping(previous).EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Позиции принимаются и до копирования буфера, поэтому переводятся в индексы
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        const size_t index = IndexOf(pos);
+        CowSimpleVector previous;
+        Vector& items = MutableKeeping(previous);
+        return items.Insert(items.begin() + index, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t index = IndexOf(pos);
+        CowSimpleVector previous;
+        Vector& items = MutableKeeping(previous);
+        return items.Insert(items.begin() + index, std::move(value));
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = IndexOf(pos);
+        Vector& items = Mutable();
+        return items.Erase(items.begin() + index);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t index = IndexOf(first);
+        const size_t count = last - first;
+        Vector& items = Mutable();
+        return items.Erase(items.begin() + index, items.begin() + index + count);
+    }
+
+    void PopBack() {
+        HardenedCheck(!IsEmpty(), "PopBack on a non-empty container");
+        Mutable().PopBack();
+    }
+
+    // Разделённый буфер не копируется, а просто отпускается
+    void Clear() noexcept {
+        if (IsShared()) {
+            Unshare();
+        } else if (shared_) {
+            shared_->items.Clear();
+        }
+    }
+
+    void swap(CowSimpleVector& other) noexcept {
+        std::swap(shared_, other.shared_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return GetVector().begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return GetVector().end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    Iterator begin() {
+        return Mutable().begin();
+    }
+
+    Iterator end() {
+        return Mutable().end();
+    }
+
+private:
+    struct Shared {
+        explicit Shared(Vector&& vector) noexcept
+            : items(std::move(vector)) {
+        }
+
+        std::atomic<size_t> refs{1};
+        Vector items;
+    };
+
+    static const Vector& Empty() noexcept {
+        static const Vector empty;
+        return empty;
+    }
+
+    size_t IndexOf(ConstIterator pos) const noexcept {
+        HardenedCheck(pos >= cbegin() && pos <= cend(), "begin <= pos <= end");
+        return static_cast<size_t>(pos - cbegin());
+    }
+
+    // Как Mutable, но ссылка на прежний разделённый буфер переходит в previous.
+    // Другие копии могут отпустить его в любой момент, и тогда буфер живёт,
+    // пока не разрушится previous
+    Vector& MutableKeeping(CowSimpleVector& previous) {
+        if (IsShared()) {
+            Shared* copy = new Shared(Vector(shared_->items));
+            previous.shared_ = std::exchange(shared_, copy);
+            return shared_->items;
+        }
+        return Mutable();
+    }
+
+    void Unshare() noexcept {
+        if (shared_ && shared_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete shared_;
+        }
+        shared_ = nullptr;
+    }
+
+    Shared* shared_ = nullptr;
+};
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator==(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                       const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return lhs.GetVector() == rhs.GetVector();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator!=(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                       const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator<(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                      const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return lhs.GetVector() < rhs.GetVector();
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator<=(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                       const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator>(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                      const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator>=(const CowSimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                       const CowSimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
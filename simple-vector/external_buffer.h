@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+// Аллокатор для буферов, пришедших извне (из C API, сетевого декодера):
+// такой буфер освобождается переданным вместе с ним deleter, а память,
+// выделенная при росте вектора, — через std::allocator.
+template <typename Type>
+class ExternalBufferAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using Deleter = std::function<void(Type*)>;
+
+    ExternalBufferAllocator() noexcept = default;
+
+    ExternalBufferAllocator(Type* buffer, Deleter deleter)
+        : external_(std::make_shared<External>(External{buffer, std::move(deleter)})) {
+    }
+
+    // Чужой буфер хранит элементы Type, поэтому при rebind он не передаётся
+    template <typename Other>
+    ExternalBufferAllocator(const ExternalBufferAllocator<Other>&) noexcept {
+    }
+
+    ExternalBufferAllocator select_on_container_copy_construction() const noexcept {
+        return ExternalBufferAllocator();
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        return std::allocator<Type>().allocate(size);
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept {
+        if (external_ && ptr == external_->buffer) {
+            external_->buffer = nullptr;
+            Deleter deleter = std::move(external_->deleter);
+            deleter(ptr);
+        } else {
+            std::allocator<Type>().deallocate(ptr, size);
+        }
+    }
+
+    // Равны копии одного аллокатора: только они освобождают принятый им буфер.
+    // Сравнивается общее состояние deleter, а не то, жив ли ещё буфер, поэтому
+    // результат не меняется со временем
+    bool operator==(const ExternalBufferAllocator& other) const noexcept {
+        return external_ == other.external_;
+    }
+
+    bool operator!=(const ExternalBufferAllocator& other) const noexcept {
+        return !(*this == other);
+    }
+
+    bool HoldsBuffer() const noexcept {
+        return external_ && external_->buffer;
+    }
+
+private:
+    struct External {
+        Type* buffer;
+        Deleter deleter;
+    };
+
+    std::shared_ptr<External> external_;
+};
+
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+using ExternalSimpleVector = SimpleVector<Type, ExternalBufferAllocator<Type>, GrowthPolicy>;
+
+// Вектор над чужим буфером: data вмещает capacity элементов, первые size живы.
+// Буфер освобождается deleter(data), когда вектор вырастет из него или будет разрушен.
+template <typename Type, typename Deleter, typename GrowthPolicy = DoublingGrowth>
+ExternalSimpleVector<Type, GrowthPolicy> AdoptExternal(Type* data, size_t size, size_t capacity, Deleter deleter) {
+    ExternalSimpleVector<Type, GrowthPolicy> vector;
+    vector.Adopt(data, size, capacity, ExternalBufferAllocator<Type>(data, std::move(deleter)));
+    return vector;
+}
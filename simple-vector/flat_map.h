@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "flat_set.h"
+#include "simple_vector.h"
+
+// Упорядоченный словарь в непрерывном SimpleVector пар (ключ, значение),
+// отсортированных по ключу. Поиск двоичный без ветвлений (BranchlessLowerBound).
+// Ключ пары менять через итератор нельзя: это нарушит порядок.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using Vector = SimpleVector<value_type>;
+    using Iterator = typename Vector::Iterator;
+    using ConstIterator = typename Vector::ConstIterator;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_(comp) {
+    }
+
+    // Из пар с равными ключами остаётся первая
+    FlatMap(std::initializer_list<value_type> init, const Compare& comp = Compare())
+        : comp_(comp) {
+        InsertSorted(init.begin(), init.end());
+    }
+
+    size_t GetSize() const noexcept {
+        return items_.GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return items_.GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return items_.IsEmpty();
+    }
+
+    const Vector& GetVector() const noexcept {
+        return items_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        items_.Reserve(new_capacity);
+    }
+
+    void ShrinkToFit() {
+        items_.ShrinkToFit();
+    }
+
+    void Clear() noexcept {
+        items_.Clear();
+    }
+
+    Iterator LowerBound(const Key& key) {
+        return const_cast<Iterator>(std::as_const(*this).LowerBound(key));
+    }
+
+    ConstIterator LowerBound(const Key& key) const {
+        return BranchlessLowerBound(items_.begin(), items_.GetSize(), key,
+                                    [this](const value_type& item, const Key& k) {
+                                        return comp_(item.first, k);
+                                    });
+    }
+
+    Iterator Find(const Key& key) {
+        return const_cast<Iterator>(std::as_const(*this).Find(key));
+    }
+
+    ConstIterator Find(const Key& key) const {
+        const ConstIterator it = LowerBound(key);
+        return it != end() && !comp_(key, it->first) ? it : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    Value& At(const Key& key) {
+        return const_cast<Value&>(std::as_const(*this).At(key));
+    }
+
+    const Value& At(const Key& key) const {
+        const ConstIterator it = Find(key);
+        if (it == end()) {
+            throw std::out_of_range("Key not found");
+        }
+        return it->second;
+    }
+
+    // Отсутствующий ключ вставляется со значением Value()
+    Value& operator[](const Key& key) {
+        return TryEmplace(key).first->second;
+    }
+
+    Value& operator[](Key&& key) {
+        return TryEmplace(std::move(key)).first->second;
+    }
+
+    // Возвращает позицию пары и признак того, что она была вставлена
+    std::pair<Iterator, bool> Insert(const value_type& item) {
+        return TryEmplace(item.first, item.second);
+    }
+
+    std::pair<Iterator, bool> Insert(value_type&& item) {
+        return TryEmplace(std::move(item.first), std::move(item.second));
+    }
+
+    // Значение создаётся из args, только если ключа ещё нет
+    template <typename K, typename... Args>
+    std::pair<Iterator, bool> TryEmplace(K&& key, Args&&... args) {
+        const Iterator pos = LowerBound(key);
+        if (pos != end() && !comp_(key, pos->first)) {
+            return {pos, false};
+        }
+        const Iterator inserted = items_.Emplace(pos, std::piecewise_construct,
+                                                 std::forward_as_tuple(std::forward<K>(key)),
+                                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        return {inserted, true};
+    }
+
+    template <typename V>
+    std::pair<Iterator, bool> InsertOrAssign(const Key& key, V&& value) {
+        const auto [it, inserted] = TryEmplace(key, std::forward<V>(value));
+        if (!inserted) {
+            it->second = std::forward<V>(value);
+        }
+        return {it, inserted};
+    }
+
+    // Добавляет диапазон пар за одно слияние; из пар с равными ключами
+    // остаётся уже бывшая в словаре, затем первая из диапазона
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void InsertSorted(InputIt first, InputIt last) {
+        const size_t old_size = items_.GetSize();
+        items_.Append(first, last);
+        if (items_.GetSize() == old_size) {
+            return;
+        }
+        const auto by_key = [this](const value_type& lhs, const value_type& rhs) {
+            return comp_(lhs.first, rhs.first);
+        };
+        const auto middle = items_.begin() + old_size;
+        if (!std::is_sorted(middle, items_.end(), by_key)) {
+            std::stable_sort(middle, items_.end(), by_key);
+        }
+        std::inplace_merge(items_.begin(), middle, items_.end(), by_key);
+        const auto unique_end = std::unique(items_.begin(), items_.end(),
+                                            [&by_key](const value_type& lhs, const value_type& rhs) {
+                                                return !by_key(lhs, rhs);
+                                            });
+        items_.Erase(unique_end, items_.end());
+    }
+
+    template <typename Range>
+    void InsertSorted(const Range& range) {
+        InsertSorted(std::begin(range), std::end(range));
+    }
+
+    size_t Erase(const Key& key) {
+        const ConstIterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        items_.Erase(it);
+        return 1;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        return items_.Erase(pos);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        return items_.Erase(first, last);
+    }
+
+    void swap(FlatMap& other) noexcept {
+        items_.swap(other.items_);
+        std::swap(comp_, other.comp_);
+    }
+
+    Iterator begin() noexcept {
+        return items_.begin();
+    }
+
+    Iterator end() noexcept {
+        return items_.end();
+    }
+
+    ConstIterator begin() const noexcept {
+        return items_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return items_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    Vector items_;
+    Compare comp_;
+};
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator==(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return lhs.GetVector() == rhs.GetVector();
+}
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator!=(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator<(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return lhs.GetVector() < rhs.GetVector();
+}
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator<=(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator>(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Key, typename Value, typename Compare>
+inline bool operator>=(const FlatMap<Key, Value, Compare>& lhs, const FlatMap<Key, Value, Compare>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include "simple_vector.h"
+
+// Нижняя граница без ветвлений: на каждом шаге выбор половины сводится
+// к условному присваиванию (cmov), и предсказатель переходов не ошибается.
+// less(element, key) сравнивает элемент диапазона с ключом.
+template <typename Type, typename Key, typename Less>
+Type* BranchlessLowerBound(Type* first, size_t size, const Key& key, Less less) {
+    if (size == 0) {
+        return first;
+    }
+    while (size > 1) {
+        const size_t half = size / 2;
+        first = less(first[half], key) ? first + half : first;
+        size -= half;
+    }
+    return first + (less(*first, key) ? 1 : 0);
+}
+
+// Упорядоченное множество в непрерывном SimpleVector: поиск двоичный,
+// обход идёт по памяти подряд. Вставка одного элемента сдвигает хвост,
+// поэтому наборы элементов добавляются через InsertSorted одним слиянием.
+template <typename Type, typename Compare = std::less<Type>>
+class FlatSet {
+public:
+    using Vector = SimpleVector<Type>;
+    using Iterator = typename Vector::ConstIterator;
+    using ConstIterator = typename Vector::ConstIterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp)
+        : comp_(comp) {
+    }
+
+    FlatSet(std::initializer_list<Type> init, const Compare& comp = Compare())
+        : comp_(comp) {
+        InsertSorted(init.begin(), init.end());
+    }
+
+    // Забирает элементы vector; порядок и повторы не важны
+    explicit FlatSet(Vector&& vector, const Compare& comp = Compare())
+        : items_(std::move(vector)),
+          comp_(comp) {
+        std::sort(items_.begin(), items_.end(), comp_);
+        EraseDuplicates();
+    }
+
+    size_t GetSize() const noexcept {
+        return items_.GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return items_.GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return items_.IsEmpty();
+    }
+
+    const Vector& GetVector() const noexcept {
+        return items_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        items_.Reserve(new_capacity);
+    }
+
+    void ShrinkToFit() {
+        items_.ShrinkToFit();
+    }
+
+    void Clear() noexcept {
+        items_.Clear();
+    }
+
+    ConstIterator LowerBound(const Type& key) const {
+        return BranchlessLowerBound(items_.begin(), items_.GetSize(), key, comp_);
+    }
+
+    ConstIterator UpperBound(const Type& key) const {
+        return std::upper_bound(items_.begin(), items_.end(), key, comp_);
+    }
+
+    ConstIterator Find(const Type& key) const {
+        const ConstIterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    bool Contains(const Type& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Type& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Возвращает позицию элемента и признак того, что он был вставлен
+    std::pair<Iterator, bool> Insert(const Type& value) {
+        return Emplace(value);
+    }
+
+    std::pair<Iterator, bool> Insert(Type&& value) {
+        return Emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    std::pair<Iterator, bool> Emplace(Args&&... args) {
+        Type value(std::forward<Args>(args)...);
+        const ConstIterator pos = LowerBound(value);
+        if (pos != end() && !comp_(value, *pos)) {
+            return {pos, false};
+        }
+        return {items_.Insert(pos, std::move(value)), true};
+    }
+
+    // Добавляет диапазон за одно слияние вместо сдвига на каждый элемент.
+    // Если диапазон уже упорядочен по Compare, сортировка хвоста линейна по сравнениям.
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void InsertSorted(InputIt first, InputIt last) {
+        const size_t old_size = items_.GetSize();
+        items_.Append(first, last);
+        if (items_.GetSize() == old_size) {
+            return;
+        }
+        const auto middle = items_.begin() + old_size;
+        if (!std::is_sorted(middle, items_.end(), comp_)) {
+            std::sort(middle, items_.end(), comp_);
+        }
+        // стабильное слияние: из равных остаётся уже бывший в множестве элемент
+        std::inplace_merge(items_.begin(), middle, items_.end(), comp_);
+        EraseDuplicates();
+    }
+
+    template <typename Range>
+    void InsertSorted(const Range& range) {
+        InsertSorted(std::begin(range), std::end(range));
+    }
+
+    size_t Erase(const Type& key) {
+        const ConstIterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        items_.Erase(it);
+        return 1;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        return items_.Erase(pos);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        return items_.Erase(first, last);
+    }
+
+    void swap(FlatSet& other) noexcept {
+        items_.swap(other.items_);
+        std::swap(comp_, other.comp_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return items_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return items_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    // В упорядоченном векторе удаляет повторы, оставляя первый из равных
+    void EraseDuplicates() {
+        const auto last = std::unique(items_.begin(), items_.end(), [this](const Type& lhs, const Type& rhs) {
+            return !comp_(lhs, rhs);
+        });
+        items_.Erase(last, items_.end());
+    }
+
+    Vector items_;
+    Compare comp_;
+};
+
+template <typename Type, typename Compare>
+inline bool operator==(const FlatSet<Type, Compare>& lhs, const FlatSet<Type, Compare>& rhs) {
+    return lhs.GetVector() == rhs.GetVector();
+}
+
+template <typename Type, typename Compare>
+inline bool operator!=(const FlatSet<Type, Compare>& lhs, const FlatSet<Type, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Compare>
+inline bool operator<(const FlatSet<Type, Compare>& lhs, const FlatSet<Type, Compare>& rhs) {
+    return lhs.GetVector() < rhs.GetVector();
+}
+
+template <typename Type, typename Compare>
+inline bool operator<=(const FlatSet<Type, Compare>& lhs, const FlatSet<Type, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Compare>
+inline bool operator>(const FlatSet<Type, Compare>& lhs, const FlatSet<Type, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Compare>
+inline bool operator>=(const FlatSet<Type, Compare>& lhs, const FlatSet<Type, Compare>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#ifdef SIMPLE_VECTOR_USE_NALLOCX
+#include <jemalloc/jemalloc.h>
+#endif
+
+// Политики роста ёмкости. Grow возвращает новую ёмкость не меньше required
+// для буфера, в котором сейчас capacity элементов размера element_size.
+
+constexpr size_t ClampCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    const size_t max_capacity = std::numeric_limits<size_t>::max() / element_size;
+    return std::max(std::min(capacity, max_capacity), required);
+}
+
+// Удваивает ёмкость, начиная с одного элемента
+struct DoublingGrowth {
+    static constexpr size_t Grow(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t grown = capacity > std::numeric_limits<size_t>::max() / 2 ? capacity : capacity * 2;
+        return ClampCapacity(capacity ? grown : 1, required, element_size);
+    }
+};
+
+// Рост в 1.5 раза: освобождённые блоки со временем снова вмещают новый буфер
+struct OneAndHalfGrowth {
+    static constexpr size_t Grow(size_t capacity, size_t required, size_t element_size) noexcept {
+        return ClampCapacity(capacity + std::max<size_t>(capacity / 2, 1), required, element_size);
+    }
+};
+
+// Первое выделение занимает не меньше кеш-линии, дальше рост по Base
+template <typename Base = DoublingGrowth, size_t CacheLineSize = 64>
+struct CacheLineGrowth {
+    static constexpr size_t Grow(size_t capacity, size_t required, size_t element_size) noexcept {
+        if (capacity == 0) {
+            return std::max<size_t>({required, CacheLineSize / element_size, 1});
+        }
+        return Base::Grow(capacity, required, element_size);
+    }
+};
+
+// Размер блока, который jemalloc на самом деле выделит под bytes байт:
+// 8, затем шаг 16 до 128, дальше по четыре класса на каждую степень двойки
+inline size_t JemallocSizeClass(size_t bytes) noexcept {
+#ifdef SIMPLE_VECTOR_USE_NALLOCX
+    if (bytes != 0) {
+        return nallocx(bytes, 0);
+    }
+#endif
+    if (bytes <= 8) {
+        return 8;
+    }
+    if (bytes <= 128) {
+        return (bytes + 15) & ~size_t{15};
+    }
+    size_t lg = 0;
+    for (size_t value = bytes - 1; value > 1; value >>= 1) {
+        ++lg;
+    }
+    const size_t spacing = size_t{1} << (lg - 2);
+    if (bytes > std::numeric_limits<size_t>::max() - spacing) {
+        return bytes;
+    }
+    return (bytes + spacing - 1) & ~(spacing - 1);
+}
+
+// Округляет ёмкость Base вверх до класса размеров аллокатора,
+// чтобы не терять байты, которые аллокатор всё равно выделит
+template <typename Base = DoublingGrowth>
+struct SizeClassGrowth {
+    static size_t Grow(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t grown = Base::Grow(capacity, required, element_size);
+        if (grown > std::numeric_limits<size_t>::max() / element_size) {
+            return grown;
+        }
+        return std::max(JemallocSizeClass(grown * element_size) / element_size, grown);
+    }
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include "allocator_utils.h"
+#include "simple_vector.h"
+
+// Аллокатор для очень больших буферов (гигабайты элементов). Буферы от threshold
+// байт отображаются анонимным mmap с длиной, кратной huge page: либо с прозрачными
+// huge pages (MADV_HUGEPAGE), либо из заранее выделенного пула (MAP_HUGETLB).
+// Страницы можно привязать к узлам NUMA или чередовать между ними (mbind).
+// Меньшие буферы берутся у std::allocator, так что короткие векторы не занимают по 2 МиБ.
+// Через reallocate большой буфер растёт mremap без копирования, и SimpleVector
+// тривиально переносимых элементов растёт на месте (см. kHasReallocate).
+
+// Размер huge page на x86-64 и в конфигурации по умолчанию на AArch64
+inline constexpr size_t kHugePageSize = size_t{2} << 20;
+
+enum class HugePageMode {
+    // MADV_HUGEPAGE: ядро собирает huge pages, когда может; работает без настройки системы
+    kTransparent,
+    // MAP_HUGETLB: страницы из пула vm.nr_hugepages. Если пул пуст, буфер
+    // отображается обычными страницами с MADV_HUGEPAGE
+    kHugeTlb,
+};
+
+enum class NumaPolicy {
+    kDefault,
+    // Все страницы только на узлах из node_mask
+    kBind,
+    // Страницы по очереди на узлах из node_mask: равная пропускная способность всем потокам
+    kInterleave,
+};
+
+struct HugePageOptions {
+    // Буферы меньше порога (в байтах) выделяются std::allocator
+    size_t threshold = kHugePageSize;
+    HugePageMode mode = HugePageMode::kTransparent;
+    NumaPolicy numa = NumaPolicy::kDefault;
+    // Бит i — узел NUMA i
+    unsigned long node_mask = 0;
+};
+
+inline bool operator==(const HugePageOptions& lhs, const HugePageOptions& rhs) noexcept {
+    return lhs.threshold == rhs.threshold && lhs.mode == rhs.mode && lhs.numa == rhs.numa &&
+           lhs.node_mask == rhs.node_mask;
+}
+
+inline bool operator!=(const HugePageOptions& lhs, const HugePageOptions& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <typename Type>
+class HugePageAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename Other>
+    struct rebind {
+        using other = HugePageAllocator<Other>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    explicit HugePageAllocator(const HugePageOptions& options) noexcept
+        : options_(options) {
+    }
+
+    template <typename Other>
+    HugePageAllocator(const HugePageAllocator<Other>& other) noexcept
+        : options_(other.GetOptions()) {
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (size > (std::numeric_limits<size_t>::max() - 2 * kHugePageSize) / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        if (!IsMapped(size)) {
+            return std::allocator<Type>().allocate(size);
+        }
+        return static_cast<Type*>(Map(MappedLength(size)));
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept {
+        if (!IsMapped(size)) {
+            std::allocator<Type>().deallocate(ptr, size);
+        } else {
+            ::munmap(ptr, MappedLength(size));
+        }
+    }
+
+    // Отображение меняет длину через mremap: физические страницы не копируются,
+    // меняются только таблицы страниц. Переход через порог копирует байты.
+    Type* reallocate(Type* ptr, size_t old_size, size_t new_size) {
+        const size_t kept_bytes = std::min(old_size, new_size) * sizeof(Type);
+        if (IsMapped(old_size) && IsMapped(new_size)) {
+            const size_t old_length = MappedLength(old_size);
+            const size_t new_length = MappedLength(new_size);
+            if (old_length == new_length || ::mremap(ptr, old_length, new_length, 0) != MAP_FAILED) {
+                return ptr;
+            }
+            // На месте не вырасти. MREMAP_MAYMOVE выбрал бы адрес, не выровненный
+            // на huge page, поэтому страницы переносятся в выровненный участок,
+            // отображённый заранее. Перенесённое отображение заменяет его вместе
+            // с подсказкой и политикой NUMA и наследует их от старого, поэтому
+            // они назначаются заново: это касается ещё не тронутых страниц хвоста
+            Type* new_ptr = static_cast<Type*>(Map(new_length));
+            if (::mremap(ptr, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, new_ptr) != MAP_FAILED) {
+                // отказ madvise у отображения MAP_HUGETLB ожидаем, а маску узлов
+                // ядро уже приняло в Map
+                ::madvise(new_ptr, new_length, MADV_HUGEPAGE);
+                static_cast<void>(BindToNodes(new_ptr, new_length));
+                return new_ptr;
+            }
+            // отображения MAP_HUGETLB увеличивать mremap старые ядра не умеют
+            std::memcpy(static_cast<void*>(new_ptr), ptr, kept_bytes);
+            ::munmap(ptr, old_length);
+            return new_ptr;
+        }
+        Type* new_ptr = allocate(new_size);
+        std::memcpy(static_cast<void*>(new_ptr), ptr, kept_bytes);
+        deallocate(ptr, old_size);
+        return new_ptr;
+    }
+
+    const HugePageOptions& GetOptions() const noexcept {
+        return options_;
+    }
+
+private:
+    bool IsMapped(size_t size) const noexcept {
+        return size != 0 && size * sizeof(Type) >= options_.threshold;
+    }
+
+    static size_t MappedLength(size_t size) noexcept {
+        return (size * sizeof(Type) + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    }
+
+    void* Map(size_t length) const {
+        void* data = MAP_FAILED;
+        if (options_.mode == HugePageMode::kHugeTlb) {
+            data = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        if (data == MAP_FAILED) {
+            data = MapAligned(length);
+            // подсказка: отказ ядра оставляет буфер на обычных страницах
+            ::madvise(data, length, MADV_HUGEPAGE);
+        }
+        // страницы ещё не тронуты, так что политика действует на все
+        if (const int error = BindToNodes(data, length); error != 0) {
+            ::munmap(data, length);
+            throw std::system_error(error, std::generic_category(), "mbind");
+        }
+        return data;
+    }
+
+    // Политика NUMA для страниц [data, data + length), которые ещё не тронуты;
+    // возвращает errno или 0
+    int BindToNodes(void* data, size_t length) const noexcept {
+        if (options_.numa == NumaPolicy::kDefault) {
+            return 0;
+        }
+        const int mode = options_.numa == NumaPolicy::kBind ? MPOL_BIND : MPOL_INTERLEAVE;
+        const unsigned long mask = options_.node_mask;
+        if (::syscall(SYS_mbind, data, length, mode, &mask, sizeof(mask) * CHAR_BIT, 0) != 0) {
+            return errno;
+        }
+        return 0;
+    }
+
+    // Прозрачные huge pages собираются только в выровненных на 2 МиБ участках:
+    // отображается запас в одну страницу, а невыровненные края возвращаются ядру
+    static void* MapAligned(size_t length) {
+        const size_t padded = length + kHugePageSize;
+        void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (start + kHugePageSize - 1) & ~(uintptr_t{kHugePageSize} - 1);
+        const size_t head = aligned - start;
+        if (head != 0) {
+            ::munmap(raw, head);
+        }
+        if (const size_t tail = padded - head - length; tail != 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    HugePageOptions options_;
+};
+
+// construct/destroy не переопределены: работают быстрые пути std::allocator
+template <typename Type>
+struct IsStdAllocator<HugePageAllocator<Type>> : std::true_type {};
+
+template <typename Type, typename Other>
+bool operator==(const HugePageAllocator<Type>& lhs, const HugePageAllocator<Other>& rhs) noexcept {
+    return lhs.GetOptions() == rhs.GetOptions();
+}
+
+template <typename Type, typename Other>
+bool operator!=(const HugePageAllocator<Type>& lhs, const HugePageAllocator<Other>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+using HugePageSimpleVector = SimpleVector<Type, HugePageAllocator<Type>, GrowthPolicy>;
@@ -1,9 +1,46 @@
+#include "bounds_check.h"
+#include "concurrent_simple_vector.h"
+#include "cow_simple_vector.h"
+#include "external_buffer.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#ifdef __linux__
+#include "huge_page_allocator.h"
+#include "mapped_file.h"
+#endif
+#include "parallel_algorithms.h"
+#include "segmented_simple_vector.h"
+#include "serialization.h"
+#include "simple_deque.h"
 #include "simple_vector.h"
+#include "simple_vector_view.h"
+#include "soa_simple_vector.h"
+#include "static_simple_vector.h"
+#include "streaming_algorithms.h"
+#include "small_simple_vector.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace std;
 
@@ -32,6 +69,121 @@ private:
     size_t x_;
 };
 
+// Подсчитывает живые объекты, чтобы проверять конструирование и разрушение элементов
+class Counted {
+public:
+    static inline int alive = 0;
+
+    explicit Counted(int value)
+        : value_(value) {
+        ++alive;
+    }
+    Counted(const Counted& other)
+        : value_(other.value_) {
+        ++alive;
+    }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() {
+        --alive;
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+private:
+    int value_;
+};
+
+// Владеющий дескриптор: перемещение нетривиально, но объект можно переносить побайтово
+class Handle {
+public:
+    explicit Handle(int value)
+        : value_(make_unique<int>(value)) {
+    }
+    int GetValue() const {
+        return *value_;
+    }
+
+private:
+    unique_ptr<int> value_;
+};
+
+template <>
+struct is_trivially_relocatable<Handle> : true_type {};
+
+// Копирование бросает исключение, когда исчерпан счётчик; перемещение не noexcept
+class ThrowingCopy {
+public:
+    static inline int copies_left = -1;
+
+    explicit ThrowingCopy(int value)
+        : value_(value) {
+    }
+    ThrowingCopy(const ThrowingCopy& other)
+        : value_(other.value_) {
+        if (copies_left == 0) {
+            throw runtime_error("copy failed"s);
+        }
+        --copies_left;
+    }
+    ThrowingCopy(ThrowingCopy&& other)
+        : value_(exchange(other.value_, -1)) {
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&& other) {
+        value_ = exchange(other.value_, -1);
+        return *this;
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+private:
+    int value_;
+};
+
+// Аллокатор с идентификатором: экземпляры с разными id не равны
+template <typename Type>
+class TaggedAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_copy_assignment = true_type;
+    using propagate_on_container_move_assignment = true_type;
+    using propagate_on_container_swap = true_type;
+
+    static inline int allocations = 0;
+
+    explicit TaggedAllocator(int id)
+        : id_(id) {
+    }
+    template <typename Other>
+    TaggedAllocator(const TaggedAllocator<Other>& other)
+        : id_(other.GetId()) {
+    }
+
+    Type* allocate(size_t n) {
+        ++allocations;
+        return allocator<Type>().allocate(n);
+    }
+    void deallocate(Type* p, size_t n) {
+        --allocations;
+        allocator<Type>().deallocate(p, n);
+    }
+
+    int GetId() const {
+        return id_;
+    }
+    bool operator==(const TaggedAllocator& other) const {
+        return id_ == other.id_;
+    }
+    bool operator!=(const TaggedAllocator& other) const {
+        return id_ != other.id_;
+    }
+
+private:
+    int id_;
+};
+
 SimpleVector<int> GenerateVector(size_t size) {
     SimpleVector<int> v(size);
     iota(v.begin(), v.end(), 1);
@@ -150,6 +302,1605 @@ void TestNoncopiableErase() {
     cout << "Done!"s << endl << endl;
 }
 
+void TestRawStorage() {
+    cout << "Test raw storage"s << endl;
+    {
+        // Counted не имеет конструктора по умолчанию
+        SimpleVector<Counted> v;
+        v.Reserve(100);
+        assert(Counted::alive == 0);
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(Counted(i));
+        }
+        assert(Counted::alive == 10);
+        v.Insert(v.begin() + 5, Counted(42));
+        assert(Counted::alive == 11);
+        assert(v[5].GetValue() == 42 && v[6].GetValue() == 5);
+        v.Erase(v.begin());
+        v.PopBack();
+        assert(Counted::alive == 9);
+        v.Reserve(1000);
+        assert(Counted::alive == 9);
+        assert(v[0].GetValue() == 1 && v[8].GetValue() == 8);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestEmplace() {
+    cout << "Test emplace"s << endl;
+    SimpleVector<X> v;
+    for (size_t i = 0; i < 5; ++i) {
+        X& x = v.EmplaceBack(i);
+        assert(x.GetX() == i);
+    }
+    auto it = v.Emplace(v.begin() + 2, 42u);
+    assert(it->GetX() == 42);
+    assert(v.GetSize() == 6);
+    assert(v[1].GetX() == 1 && v[3].GetX() == 2 && v[5].GetX() == 4);
+
+    SimpleVector<string> strings;
+    strings.EmplaceBack(3, 'a');
+    strings.Emplace(strings.begin(), "b"s);
+    // аргумент ссылается на элемент самого вектора
+    strings.Emplace(strings.begin() + 1, strings[1]);
+    assert((strings == SimpleVector<string>{"b"s, "aaa"s, "aaa"s}));
+    strings.EmplaceBack(strings[0]);
+    assert(strings.GetSize() == 4 && strings[3] == "b"s);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestTriviallyRelocatable() {
+    cout << "Test trivially relocatable"s << endl;
+    SimpleVector<uint64_t> numbers;
+    for (uint64_t i = 0; i < 100; ++i) {
+        numbers.Insert(numbers.begin() + numbers.GetSize() / 2, i);
+    }
+    assert(numbers.GetSize() == 100 && numbers[49] == 99 && numbers[50] == 98 && numbers[51] == 96);
+    numbers.Erase(numbers.begin() + 50);
+    assert(numbers.GetSize() == 99 && numbers[49] == 99 && numbers[50] == 96);
+
+    SimpleVector<Handle> handles;
+    for (int i = 0; i < 10; ++i) {
+        handles.EmplaceBack(i);
+    }
+    handles.Emplace(handles.begin(), 42);
+    handles.Erase(handles.begin() + 5);
+    assert(handles.GetSize() == 10);
+    assert(handles[0].GetValue() == 42 && handles[4].GetValue() == 3 && handles[5].GetValue() == 5);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestStrongExceptionGuarantee() {
+    cout << "Test strong exception guarantee"s << endl;
+    SimpleVector<ThrowingCopy> v;
+    v.Reserve(4);
+    for (int i = 0; i < 4; ++i) {
+        v.EmplaceBack(i);
+    }
+    const auto check_intact = [&v] {
+        assert(v.GetSize() == 4 && v.GetCapacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            assert(v[i].GetValue() == i);
+        }
+    };
+
+    ThrowingCopy::copies_left = 2;
+    try {
+        v.Reserve(8);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    check_intact();
+
+    ThrowingCopy::copies_left = 2;
+    try {
+        v.PushBack(ThrowingCopy(4));
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    check_intact();
+
+    ThrowingCopy::copies_left = -1;
+    v.Reserve(8);
+    ThrowingCopy::copies_left = 2;
+    try {
+        v.Insert(v.begin() + 1, ThrowingCopy(4));
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    assert(v.GetSize() == 4 && v[0].GetValue() == 0 && v[1].GetValue() == 1 && v[3].GetValue() == 3);
+    ThrowingCopy::copies_left = -1;
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAllocator() {
+    cout << "Test allocator"s << endl;
+    {
+        using Vector = SimpleVector<int, TaggedAllocator<int>>;
+        Vector a(TaggedAllocator<int>(1));
+        for (int i = 0; i < 100; ++i) {
+            a.PushBack(i);
+        }
+        Vector b({1, 2, 3}, TaggedAllocator<int>(2));
+        b = a;
+        assert(b.GetAllocator().GetId() == 1 && b == a);
+        Vector c(3, 7, TaggedAllocator<int>(3));
+        c.swap(b);
+        assert(c.GetAllocator().GetId() == 1 && b.GetAllocator().GetId() == 3);
+        b = move(c);
+        assert(b.GetAllocator().GetId() == 1 && b.GetSize() == 100);
+    }
+    assert(TaggedAllocator<int>::allocations == 0);
+
+    using PmrVector = SimpleVector<pmr::string, pmr::polymorphic_allocator<pmr::string>>;
+    pmr::monotonic_buffer_resource arena;
+    PmrVector v(&arena);
+    for (int i = 0; i < 10; ++i) {
+        v.EmplaceBack(100, static_cast<char>('a' + i));
+    }
+    v.Insert(v.begin(), pmr::string("first string that does not fit in SSO"));
+    for (const auto& s : v) {
+        assert(s.get_allocator().resource() == &arena);
+    }
+
+    pmr::monotonic_buffer_resource other_arena;
+    PmrVector w(&other_arena);
+    // аллокаторы не равны и не распространяются: элементы переносятся поштучно
+    w = move(v);
+    assert(w.GetAllocator().resource() == &other_arena && w.GetSize() == 11);
+    assert(w[0] == "first string that does not fit in SSO" && w[1] == pmr::string(100, 'a'));
+    for (const auto& s : w) {
+        assert(s.get_allocator().resource() == &other_arena);
+    }
+    PmrVector copy(w);
+    assert(copy.GetAllocator().resource() == pmr::get_default_resource());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSmallSimpleVector() {
+    cout << "Test small simple vector"s << endl;
+    {
+        SmallSimpleVector<Counted, 4> v;
+        assert(v.GetCapacity() == 4 && v.IsInline());
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(Counted(i));
+        }
+        assert(v.IsInline() && Counted::alive == 4);
+        const auto* object_begin = reinterpret_cast<const char*>(&v);
+        const auto* data = reinterpret_cast<const char*>(v.begin());
+        assert(data >= object_begin && data < object_begin + sizeof(v));
+
+        v.Insert(v.begin() + 1, Counted(42));
+        assert(!v.IsInline() && v.GetCapacity() == 8 && Counted::alive == 5);
+        assert(v[0].GetValue() == 0 && v[1].GetValue() == 42 && v[4].GetValue() == 3);
+
+        SmallSimpleVector<Counted, 4> small(2, Counted(7));
+        v.swap(small);
+        assert(v.IsInline() && v.GetSize() == 2 && small.GetSize() == 5 && small[1].GetValue() == 42);
+        SmallSimpleVector<Counted, 4> copy = small;
+        assert(copy.GetSize() == 5 && copy[4].GetValue() == 3);
+        v = move(copy);
+        assert(v.GetSize() == 5 && copy.GetSize() == 0);
+        v.Erase(v.begin());
+        assert(v[0].GetValue() == 42);
+    }
+    assert(Counted::alive == 0);
+
+    SmallSimpleVector<X, 2> noncopiable;
+    for (size_t i = 0; i < 5; ++i) {
+        noncopiable.EmplaceBack(i);
+    }
+    SmallSimpleVector<X, 2> moved = move(noncopiable);
+    assert(moved.GetSize() == 5 && moved[4].GetX() == 4);
+
+    SmallSimpleVector<int, 8> a = {1, 2, 3};
+    SmallSimpleVector<int, 8> b = {1, 2, 4};
+    assert(a < b && a != b && a == a);
+    cout << "Done!"s << endl << endl;
+}
+
+template <typename Vector>
+SimpleVector<size_t> CapacityHistory(size_t count) {
+    Vector v;
+    SimpleVector<size_t> capacities;
+    for (size_t i = 0; i < count; ++i) {
+        v.PushBack(static_cast<int>(i));
+        if (capacities.IsEmpty() || capacities[capacities.GetSize() - 1] != v.GetCapacity()) {
+            capacities.PushBack(v.GetCapacity());
+        }
+    }
+    return capacities;
+}
+
+void TestGrowthPolicy() {
+    cout << "Test growth policy"s << endl;
+    using Doubling = SimpleVector<int>;
+    using OneAndHalf = SimpleVector<int, allocator<int>, OneAndHalfGrowth>;
+    using CacheLine = SimpleVector<int, allocator<int>, CacheLineGrowth<>>;
+    using SizeClass = SimpleVector<int, allocator<int>, SizeClassGrowth<OneAndHalfGrowth>>;
+    assert((CapacityHistory<Doubling>(20) == SimpleVector<size_t>{1, 2, 4, 8, 16, 32}));
+    assert((CapacityHistory<OneAndHalf>(20) == SimpleVector<size_t>{1, 2, 3, 4, 6, 9, 13, 19, 28}));
+    assert((CapacityHistory<CacheLine>(40) == SimpleVector<size_t>{16, 32, 64}));
+    // 1.5 * 12 = 18 элементов = 72 байта -> класс 80 байт = 20 элементов
+    assert((CapacityHistory<SizeClass>(40) == SimpleVector<size_t>{2, 4, 8, 12, 20, 32, 48}));
+
+    assert(JemallocSizeClass(1) == 8 && JemallocSizeClass(17) == 32 && JemallocSizeClass(128) == 128);
+    assert(JemallocSizeClass(129) == 160 && JemallocSizeClass(257) == 320 && JemallocSizeClass(4097) == 5120);
+
+    SmallSimpleVector<int, 4, OneAndHalfGrowth> small = {1, 2, 3, 4};
+    small.PushBack(5);
+    assert(small.GetCapacity() == 6);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRangeInsert() {
+    cout << "Test range insert"s << endl;
+    SimpleVector<int> numbers = {1, 2, 3};
+    const SimpleVector<int> batch = {10, 20, 30, 40};
+    numbers.Insert(numbers.begin() + 1, batch.begin(), batch.end());
+    assert((numbers == SimpleVector<int>{1, 10, 20, 30, 40, 2, 3}));
+    numbers.Append(batch.begin(), batch.begin() + 2);
+    assert((numbers == SimpleVector<int>{1, 10, 20, 30, 40, 2, 3, 10, 20}));
+    auto it = numbers.Insert(numbers.begin(), 2, numbers[8]);
+    assert(it == numbers.begin());
+    assert((numbers == SimpleVector<int>{20, 20, 1, 10, 20, 30, 40, 2, 3, 10, 20}));
+
+    // хвост длиннее и короче вставляемого диапазона, без перевыделения
+    SimpleVector<string> strings = {"a"s, "b"s, "c"s, "d"s};
+    strings.Reserve(20);
+    const SimpleVector<string> words = {"x"s, "y"s};
+    strings.Insert(strings.begin() + 1, words.begin(), words.end());
+    assert((strings == SimpleVector<string>{"a"s, "x"s, "y"s, "b"s, "c"s, "d"s}));
+    const SimpleVector<string> long_words = {"p"s, "q"s, "r"s, "s"s};
+    strings.Insert(strings.end() - 1, long_words.begin(), long_words.end());
+    assert((strings == SimpleVector<string>{"a"s, "x"s, "y"s, "b"s, "c"s, "p"s, "q"s, "r"s, "s"s, "d"s}));
+    strings.Insert(strings.begin() + 9, 3, "z"s);
+    assert(strings.GetSize() == 13 && strings[9] == "z"s && strings[11] == "z"s && strings[12] == "d"s);
+    assert(strings.GetCapacity() == 20);
+
+    istringstream input("7 8 9"s);
+    SimpleVector<int> parsed = {1, 2};
+    parsed.Insert(parsed.begin() + 1, istream_iterator<int>(input), istream_iterator<int>());
+    assert((parsed == SimpleVector<int>{1, 7, 8, 9, 2}));
+
+    SmallSimpleVector<int, 4> small = {1, 2};
+    small.Insert(small.begin() + 1, batch.begin(), batch.begin() + 2);
+    assert(small.IsInline() && small.GetSize() == 4 && small[1] == 10 && small[3] == 2);
+    small.Insert(small.end(), 3, 5);
+    assert(!small.IsInline() && small.GetSize() == 7 && small[6] == 5);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRangeErase() {
+    cout << "Test range erase"s << endl;
+    SimpleVector<int> numbers = {1, 2, 3, 4, 5, 6, 7, 8};
+    auto it = numbers.Erase(numbers.begin() + 2, numbers.begin() + 5);
+    assert(*it == 6);
+    assert((numbers == SimpleVector<int>{1, 2, 6, 7, 8}));
+    assert(numbers.Erase(numbers.end(), numbers.end()) == numbers.end());
+    assert(EraseIf(numbers, [](int x) { return x % 2 == 0; }) == 3);
+    assert((numbers == SimpleVector<int>{1, 7}));
+
+    {
+        SimpleVector<Counted> counted;
+        for (int i = 0; i < 10; ++i) {
+            counted.EmplaceBack(i % 3);
+        }
+        counted.Erase(counted.begin(), counted.begin() + 2);
+        assert(Counted::alive == 8);
+        assert(EraseIf(counted, [](const Counted& c) { return c.GetValue() == 0; }) == 3);
+        assert(Counted::alive == 5 && counted.GetSize() == 5 && counted[0].GetValue() == 2);
+    }
+    assert(Counted::alive == 0);
+
+    SimpleVector<string> sessions = {"a"s, "expired"s, "b"s, "expired"s, "c"s};
+    assert(Erase(sessions, "expired"s) == 2);
+    assert((sessions == SimpleVector<string>{"a"s, "b"s, "c"s}));
+
+    SmallSimpleVector<int, 4> small = {1, 2, 3, 2};
+    assert(Erase(small, 2) == 2 && small.GetSize() == 2 && small[1] == 3);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestShrinkToFit() {
+    cout << "Test shrink to fit"s << endl;
+    {
+        SimpleVector<Counted> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Erase(v.begin() + 10, v.end());
+        assert(Counted::alive == 10 && v.GetCapacity() == 128);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 10 && v.GetSize() == 10 && v[9].GetValue() == 9);
+        v.PopBack();
+        assert(Counted::alive == 9);
+        v.Clear();
+        assert(Counted::alive == 0 && v.GetCapacity() == 10);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 0 && v.begin() == nullptr);
+        v.EmplaceBack(1);
+        assert(v.GetSize() == 1);
+    }
+    assert(Counted::alive == 0);
+
+    SmallSimpleVector<string, 4> small = {"a"s, "b"s, "c"s, "d"s, "e"s};
+    assert(!small.IsInline());
+    small.Resize(4);
+    small.ShrinkToFit();
+    assert(small.IsInline() && small.GetCapacity() == 4 && small[3] == "d"s);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestDefaultInit() {
+    cout << "Test default init"s << endl;
+    SimpleVector<double> scratch(1000, default_init);
+    assert(scratch.GetSize() == 1000 && scratch.GetCapacity() == 1000);
+    iota(scratch.begin(), scratch.end(), 0.0);
+    scratch.Resize(2000, default_init);
+    assert(scratch.GetSize() == 2000 && scratch[999] == 999.0);
+    scratch.Resize(10, default_init);
+    assert(scratch.GetSize() == 10 && scratch[9] == 9.0);
+
+    // нетривиальные типы по-прежнему конструируются по умолчанию
+    SimpleVector<X> objects(3, default_init);
+    objects.Resize(5, default_init);
+    for (const X& x : objects) {
+        assert(x.GetX() == 5);
+    }
+    SimpleVector<pmr::string, pmr::polymorphic_allocator<pmr::string>> strings(2, default_init);
+    assert(strings[1].empty());
+
+    SmallSimpleVector<int, 8> small(4, default_init);
+    iota(small.begin(), small.end(), 0);
+    small.Resize(16, default_init);
+    assert(small.GetSize() == 16 && !small.IsInline() && small[3] == 3);
+    cout << "Done!"s << endl << endl;
+}
+
+template <typename Type>
+void CheckSimdAgainstStd() {
+    for (size_t size = 0; size <= 100; ++size) {
+        SimpleVector<Type> lhs(size);
+        for (size_t i = 0; i < size; ++i) {
+            lhs[i] = static_cast<Type>(i % 7);
+        }
+        for (size_t pos = 0; pos <= size; ++pos) {
+            SimpleVector<Type> rhs(lhs);
+            if (pos < size) {
+                rhs[pos] = static_cast<Type>(pos % 2 == 0 ? 100 : -1);
+            }
+            assert((lhs == rhs) == equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+            assert((lhs < rhs) == lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+            assert((rhs < lhs) == lexicographical_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end()));
+        }
+        SimpleVector<Type> longer(lhs);
+        longer.PushBack(Type{});
+        assert(lhs < longer && !(longer < lhs) && lhs != longer);
+
+        for (Type value : {Type{0}, Type{6}, static_cast<Type>(42)}) {
+            assert(lhs.Find(value) == find(lhs.begin(), lhs.end(), value));
+            assert(lhs.Count(value) == static_cast<size_t>(count(lhs.begin(), lhs.end(), value)));
+            assert(lhs.Contains(value) == (lhs.Count(value) != 0));
+        }
+    }
+}
+
+void TestSimdAlgorithms() {
+    cout << "Test SIMD algorithms"s << endl;
+    CheckSimdAgainstStd<uint8_t>();
+    CheckSimdAgainstStd<int8_t>();
+    CheckSimdAgainstStd<int16_t>();
+    CheckSimdAgainstStd<int32_t>();
+    CheckSimdAgainstStd<uint32_t>();
+    CheckSimdAgainstStd<int64_t>();
+    CheckSimdAgainstStd<float>();
+    CheckSimdAgainstStd<double>();
+
+    // NaN не равен себе, несравнимые элементы пропускаются при упорядочивании, -0.0 == 0.0
+    const double nan = numeric_limits<double>::quiet_NaN();
+    SimpleVector<double> with_nan(40, 1.0);
+    with_nan[20] = nan;
+    assert(with_nan != with_nan);
+    assert(with_nan.Find(nan) == with_nan.end() && with_nan.Count(nan) == 0);
+    SimpleVector<double> greater_tail(with_nan);
+    greater_tail[20] = 0.0;
+    greater_tail[30] = 2.0;
+    assert(with_nan < greater_tail);
+    SimpleVector<double> zeros(40, 0.0);
+    zeros[39] = -0.0;
+    assert(zeros == SimpleVector<double>(40, 0.0) && zeros.Count(-0.0) == 40);
+
+    SmallSimpleVector<int, 8> small = {1, 2, 3, 2};
+    assert(small.Find(2) == small.begin() + 1 && small.Count(2) == 2 && !small.Contains(5));
+    assert((small < SmallSimpleVector<int, 8>{1, 2, 4}));
+
+    SimpleVector<string> words = {"a"s, "b"s, "a"s};
+    assert(words.Count("a"s) == 2 && words.Find("b"s) == words.begin() + 1);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestParallelAlgorithms() {
+    cout << "Test parallel algorithms"s << endl;
+    WorkStealingPool pool(3);
+    const ParallelOptions options{1000, &pool};
+
+    SimpleVector<double> values(100'003);
+    iota(values.begin(), values.end(), 0.0);
+    // начало не выровнено: первый кусок дополняется до границы кеш-линии
+    ParallelForEach(values.begin() + 1, values.end(), [](double& x) { x *= 2; }, options);
+    assert(values[0] == 0.0 && values[1] == 2.0 && values[100'002] == 200'004.0);
+
+    const ChunkLayout layout = MakeChunkLayout(values.begin() + 1, values.GetSize() - 1, options, 3);
+    for (size_t chunk = 1; chunk < layout.count; ++chunk) {
+        assert(reinterpret_cast<uintptr_t>(values.begin() + 1 + layout.Begin(chunk)) % kParallelCacheLine == 0);
+    }
+
+    SimpleVector<int64_t> squares(values.GetSize());
+    ParallelTransform(values, squares, [](double x) { return static_cast<int64_t>(x) / 2; }, options);
+    assert(squares[12345] == 12345);
+    const int64_t sum = ParallelReduce(squares, int64_t{0}, plus<>{}, options);
+    assert(sum == int64_t{100'002} * 100'003 / 2);
+
+    // порядок операндов сохраняется: конкатенация не коммутативна
+    SimpleVector<string> letters(5000);
+    for (size_t i = 0; i < letters.GetSize(); ++i) {
+        letters[i] = string(1, static_cast<char>('a' + i % 26));
+    }
+    string expected;
+    for (const string& letter : letters) {
+        expected += letter;
+    }
+    assert(ParallelReduce(letters, string(), plus<>{}, ParallelOptions{7, &pool}) == expected);
+
+    SimpleVector<int> shuffled(50'000);
+    for (size_t i = 0; i < shuffled.GetSize(); ++i) {
+        shuffled[i] = static_cast<int>((i * 7919) % shuffled.GetSize());
+    }
+    ParallelSort(shuffled, greater<>{}, options);
+    assert(is_sorted(shuffled.begin(), shuffled.end(), greater<>{}) && shuffled[0] == 49'999);
+
+    // вложенные вызовы и исключения из задач
+    atomic<size_t> visited{0};
+    pool.Run(8, [&](size_t) {
+        pool.Run(100, [&](size_t) { ++visited; });
+    });
+    assert(visited == 800);
+    bool thrown = false;
+    try {
+        pool.Run(10, [](size_t i) {
+            if (i == 7) {
+                throw runtime_error("task failed"s);
+            }
+        });
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // без рабочих потоков всё выполняется в вызывающем
+    WorkStealingPool serial(0);
+    assert(ParallelReduce(squares, int64_t{0}, plus<>{}, ParallelOptions{0, &serial}) == sum);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAlignedStorage() {
+    cout << "Test aligned storage"s << endl;
+    AlignedSimpleVector<float> v;
+    for (int i = 0; i < 100; ++i) {
+        v.PushBack(static_cast<float>(i));
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        assert(v.GetCapacity() % 16 == 0);
+    }
+    // ёмкость растёт удвоением, но округляется до 16 float
+    assert(v.GetCapacity() == 128 && v[99] == 99.0f);
+    v.Erase(v.begin() + 20, v.end());
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 32 && v.GetSize() == 20);
+    const float* shrunk = v.begin();
+    v.ShrinkToFit();
+    assert(v.begin() == shrunk);
+    // округление ёмкости у границы size_t не переполняется
+    try {
+        v.Reserve(numeric_limits<size_t>::max() - 3);
+        assert(false);
+    } catch (const bad_array_new_length&) {
+        assert(v.GetCapacity() == 32 && v.GetSize() == 20);
+    }
+
+    AlignedSimpleVector<double, 128> reserved(Reserve(3));
+    assert(reserved.GetCapacity() == 16 && reinterpret_cast<uintptr_t>(reserved.begin()) % 128 == 0);
+    AlignedSimpleVector<double, 128> copy(5, 1.5);
+    reserved = copy;
+    assert(reserved == copy && reinterpret_cast<uintptr_t>(reserved.begin()) % 128 == 0);
+
+    // элементы крупнее выравнивания и нетривиальные типы
+    AlignedSimpleVector<string, 32> strings = {"a"s, "b"s};
+    strings.Insert(strings.begin(), "c"s);
+    assert(strings.GetCapacity() == 4 && strings[0] == "c"s && reinterpret_cast<uintptr_t>(strings.begin()) % 32 == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+#ifdef __linux__
+void TestMappedFile() {
+    cout << "Test mapped file"s << endl;
+    const string path = (filesystem::temp_directory_path() / "simple_vector_mapped_test.bin"s).string();
+    filesystem::remove(path);
+    {
+        MappedSimpleVector<int64_t> v = OpenMappedVector<int64_t>(path);
+        assert(v.IsEmpty());
+        for (int64_t i = 0; i < 10'000; ++i) {
+            v.PushBack(i);
+        }
+        // рост через mremap: файл растёт вместе с ёмкостью
+        assert(filesystem::file_size(path) == v.GetCapacity() * sizeof(int64_t));
+        v.Insert(v.begin(), v[9'999]);
+        v.Erase(v.begin());
+        Sync(v);
+
+        // копия живёт в обычной памяти и на файл не влияет
+        MappedSimpleVector<int64_t> copy(v);
+        assert(!copy.GetAllocator().GetFile() && copy == v);
+        bool thrown = false;
+        try {
+            v = copy;
+        } catch (const logic_error&) {
+            thrown = true;
+        }
+        assert(thrown && v.GetSize() == 10'000);
+    }
+    assert(filesystem::file_size(path) == 10'000 * sizeof(int64_t));
+    {
+        MappedSimpleVector<int64_t> v = OpenMappedVector<int64_t>(path, MappedFileOptions{true, MappedAccess::kSequential});
+        assert(v.GetSize() == 10'000 && v.GetCapacity() == 10'000 && v[1234] == 1234);
+        v[0] = 42;
+        // добавленное после последнего Sync при закрытии отбрасывается
+        v.PushBack(1);
+        v.ShrinkToFit();
+    }
+    {
+        MappedSimpleVector<int64_t> v = OpenMappedVector<int64_t>(path);
+        assert(v.GetSize() == 10'000 && v[0] == 42 && v[9'999] == 9'999);
+        v.Resize(3);
+        Sync(v);
+    }
+    assert(filesystem::file_size(path) == 3 * sizeof(int64_t));
+
+    {
+        ofstream(path, ios::binary | ios::trunc) << "abc"s;
+    }
+    bool thrown = false;
+    try {
+        OpenMappedVector<int32_t>(path);
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    filesystem::remove(path);
+    cout << "Done!"s << endl << endl;
+}
+#endif
+
+void TestSerialization() {
+    cout << "Test serialization"s << endl;
+    struct Point {
+        int32_t x;
+        double y;
+    };
+    SimpleVector<Point> points;
+    for (int32_t i = 0; i < 1000; ++i) {
+        points.PushBack(Point{i, i * 0.5});
+    }
+
+    stringstream stream;
+    WriteTo(stream, points);
+    assert(stream.str().size() == sizeof(SerializationHeader) + 1000 * sizeof(Point));
+    SimpleVector<Point> restored = {Point{-1, -1.0}};
+    ReadFrom(stream, restored);
+    assert(restored.GetSize() == 1000 && restored.GetCapacity() == 1000);
+    assert(restored[999].x == 999 && restored[999].y == 499.5);
+
+    // тип элемента записан в заголовке
+    stream.clear();
+    stream.seekg(0);
+    SimpleVector<int64_t> wrong_type = {1, 2};
+    bool thrown = false;
+    try {
+        ReadFrom(stream, wrong_type);
+    } catch (const SerializationError&) {
+        thrown = true;
+    }
+    assert(thrown && wrong_type.IsEmpty());
+
+    string truncated = stream.str();
+    truncated.resize(truncated.size() - 1);
+    istringstream truncated_stream(truncated);
+    thrown = false;
+    try {
+        ReadFrom(truncated_stream, restored);
+    } catch (const SerializationError&) {
+        thrown = true;
+    }
+    assert(thrown && restored.IsEmpty());
+
+    // заголовок с огромным размером без данных: память не выделяется под заявленное
+    SerializationHeader hostile = MakeSerializationHeader<Point>(size_t{1} << 40);
+    const string hostile_bytes(reinterpret_cast<const char*>(&hostile), sizeof(hostile));
+    istringstream hostile_stream(hostile_bytes + string(100, '\0'));
+    thrown = false;
+    try {
+        ReadFrom(hostile_stream, restored);
+    } catch (const SerializationError&) {
+        thrown = true;
+    }
+    assert(thrown && restored.IsEmpty() && restored.GetCapacity() * sizeof(Point) <= kSerializationChunkBytes);
+
+    const string path = (filesystem::temp_directory_path() / "simple_vector_serialization_test.bin"s).string();
+    SimpleVector<float> values(100'000);
+    iota(values.begin(), values.end(), 0.0f);
+    const int out = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    assert(out >= 0);
+    WriteTo(out, values);
+    WriteTo(out, SimpleVector<float>());
+    ::close(out);
+    const int in = ::open(path.c_str(), O_RDONLY);
+    SimpleVector<float> read_values;
+    ReadFrom(in, read_values);
+    assert(read_values == values);
+    ReadFrom(in, read_values);
+    assert(read_values.IsEmpty());
+    ::close(in);
+
+    // у обычного файла заявленный размер сверяется с его длиной до выделения
+    const int hostile_out = ::open(path.c_str(), O_WRONLY | O_TRUNC);
+    WriteAll(hostile_out, hostile_bytes.data(), hostile_bytes.size());
+    ::close(hostile_out);
+    const int hostile_in = ::open(path.c_str(), O_RDONLY);
+    SimpleVector<Point> hostile_points;
+    thrown = false;
+    try {
+        ReadFrom(hostile_in, hostile_points);
+    } catch (const SerializationError&) {
+        thrown = true;
+    }
+    assert(thrown && hostile_points.GetCapacity() == 0);
+    ::close(hostile_in);
+    filesystem::remove(path);
+
+    // из канала длина неизвестна: чтение кусками
+    SimpleVector<float> large(600'000);
+    iota(large.begin(), large.end(), 0.0f);
+    int pipe_fds[2];
+    assert(::pipe(pipe_fds) == 0);
+    thread writer([&] {
+        WriteTo(pipe_fds[1], large);
+        ::close(pipe_fds[1]);
+    });
+    SimpleVector<float> piped;
+    ReadFrom(pipe_fds[0], piped);
+    writer.join();
+    ::close(pipe_fds[0]);
+    assert(piped == large && piped.GetCapacity() == large.GetSize());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAdoptRelease() {
+    cout << "Test adopt and release"s << endl;
+    // буфер из C API: malloc и free
+    int frees = 0;
+    int* raw = static_cast<int*>(malloc(4 * sizeof(int)));
+    for (int i = 0; i < 3; ++i) {
+        raw[i] = i;
+    }
+    {
+        ExternalSimpleVector<int> v = AdoptExternal(raw, 3, 4, [&frees](int* ptr) {
+            ++frees;
+            free(ptr);
+        });
+        assert(v.begin() == raw && v.GetSize() == 3 && v.GetCapacity() == 4);
+        v.PushBack(3);
+        assert(v.begin() == raw && frees == 0);
+        // рост освобождает чужой буфер его же deleter
+        v.PushBack(4);
+        assert(v.begin() != raw && frees == 1 && v[4] == 4);
+        ExternalSimpleVector<int> copy(v);
+        assert(copy == v);
+    }
+    assert(frees == 1);
+
+    // без роста буфер освобождается при разрушении вектора
+    {
+        ExternalSimpleVector<int> v = AdoptExternal(static_cast<int*>(malloc(sizeof(int))), 0, 1, [&frees](int* ptr) {
+            ++frees;
+            free(ptr);
+        });
+        v.PushBack(1);
+        ExternalSimpleVector<int> moved(std::move(v));
+        assert(frees == 1 && moved[0] == 1);
+    }
+    assert(frees == 2);
+
+    // обмен буфером с кодом, работающим через тот же аллокатор
+    {
+        SimpleVector<Counted> v;
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        ReleasedBuffer<Counted, allocator<Counted>> buffer = v.Release();
+        assert(v.IsEmpty() && v.GetCapacity() == 0 && v.begin() == nullptr);
+        assert(buffer.size == 5 && buffer.capacity == 8 && Counted::alive == 5);
+
+        SimpleVector<Counted> other;
+        other.EmplaceBack(42);
+        other.Adopt(buffer.data, buffer.size, buffer.capacity);
+        assert(Counted::alive == 5 && other.GetSize() == 5 && other[4].GetValue() == 4);
+
+        buffer = other.Release();
+        destroy(buffer.data, buffer.data + buffer.size);
+        buffer.allocator.deallocate(buffer.data, buffer.capacity);
+    }
+    assert(Counted::alive == 0);
+
+    // polymorphic_allocator не присваивается: буфер принимается от равного аллокатора
+    {
+        using PmrVector = SimpleVector<int, pmr::polymorphic_allocator<int>>;
+        pmr::monotonic_buffer_resource arena;
+        PmrVector v(3, 7, pmr::polymorphic_allocator<int>(&arena));
+        ReleasedBuffer<int, pmr::polymorphic_allocator<int>> buffer = v.Release();
+        PmrVector other{pmr::polymorphic_allocator<int>(&arena)};
+        other.PushBack(1);
+        other.Adopt(buffer.data, buffer.size, buffer.capacity, buffer.allocator);
+        assert(other.GetSize() == 3 && other[2] == 7 && other.GetAllocator().resource() == &arena);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+int64_t SumOf(ConstSimpleVectorView<int> view) {
+    return accumulate(view.begin(), view.end(), int64_t{0});
+}
+
+void TestSimpleVectorView() {
+    cout << "Test simple vector view"s << endl;
+    static_assert(is_trivially_copyable_v<SimpleVectorView<int>>);
+    static_assert(!is_convertible_v<const SimpleVector<int>&, SimpleVectorView<int>>);
+
+    SimpleVector<int> v(100);
+    iota(v.begin(), v.end(), 0);
+    assert(SumOf(v) == 4950);
+
+    SimpleVectorView<int> all = v;
+    SimpleVectorView<int> middle = all.Subview(10, 20);
+    assert(middle.GetSize() == 20 && middle[0] == 10 && middle.begin() == v.begin() + 10);
+    assert(SumOf(middle) == 390);
+    assert(all.Subview(90).GetSize() == 10 && all.Subview(100).IsEmpty());
+    bool thrown = false;
+    try {
+        static_cast<void>(all.Subview(101));
+    } catch (const out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // запись через представление меняет вектор
+    for (int& x : middle.Subview(0, 5)) {
+        x = -1;
+    }
+    assert(v[14] == -1 && v[15] == 15);
+    assert(middle.Count(-1) == 5 && middle.Find(15) == v.begin() + 15 && !middle.Contains(99));
+
+    SimpleVector<int> copy(v);
+    assert(all == copy && all.Subview(0, 50) < copy);
+    ConstSimpleVectorView<int> constant = all;
+    assert(constant == all && constant.Subview(1) > all && constant.At(99) == 99);
+
+    SmallSimpleVector<int, 4> small = {1, 2, 3};
+    assert(SumOf(small) == 6);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestCowSimpleVector() {
+    cout << "Test copy-on-write vector"s << endl;
+    CowSimpleVector<int> original(SimpleVector<int>(1000, 7));
+    const int* buffer = original.GetVector().begin();
+
+    CowSimpleVector<int> copy = original;
+    assert(copy.IsShared() && original.IsShared() && copy.GetVector().begin() == buffer);
+    const CowSimpleVector<int>& const_copy = copy;
+    assert(const_copy[999] == 7 && const_copy.Count(7) == 1000);
+    assert(copy.GetVector().begin() == buffer);
+
+    // первая запись копирует буфер, оригинал не меняется
+    copy[0] = 1;
+    assert(!copy.IsShared() && !original.IsShared());
+    assert(copy.GetVector().begin() != buffer && original.GetVector().begin() == buffer);
+    assert(original[0] == 7 && copy[0] == 1 && copy != original && copy < original);
+
+    // аргумент может ссылаться на разделённый буфер
+    CowSimpleVector<string> words = {"alpha"s, "beta"s};
+    CowSimpleVector<string> words_copy = words;
+    words.PushBack(as_const(words)[0]);
+    words.Insert(as_const(words).begin() + 1, "gamma"s);
+    assert(words.GetSize() == 4 && words[0] == words[3] && words[1] == "gamma"s);
+    assert(words_copy.GetSize() == 2 && !words_copy.IsShared());
+    words_copy = words;
+    words.Erase(as_const(words).begin());
+    assert(words_copy.GetSize() == 4 && words.GetSize() == 3 && words[0] == "gamma"s);
+    words_copy.Clear();
+    assert(words_copy.IsEmpty() && words.GetSize() == 3);
+
+    CowSimpleVector<int> empty;
+    assert(empty.IsEmpty() && empty.begin() == nullptr);
+    empty.PushBack(1);
+    assert(empty.GetSize() == 1);
+
+    // снимки передаются в потоки и меняются там независимо
+    SimpleVector<thread> workers;
+    for (int i = 0; i < 4; ++i) {
+        workers.EmplaceBack([snapshot = original, i]() mutable {
+            assert(snapshot[500] == 7);
+            snapshot.PushBack(i);
+            assert(snapshot.GetSize() == 1001 && !snapshot.IsShared());
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    assert(original.GetSize() == 1000 && !original.IsShared());
+
+    // аргумент ссылается на буфер, который другие потоки отпускают в это же время
+    {
+        CowSimpleVector<string> source(SimpleVector<string>(100, string(50, 'x')));
+        SimpleVector<CowSimpleVector<string>> snapshots(4, source);
+        source.Clear();
+        SimpleVector<thread> writers;
+        for (CowSimpleVector<string>& snapshot : snapshots) {
+            writers.EmplaceBack([&snapshot] {
+                snapshot.PushBack(as_const(snapshot)[0]);
+                snapshot.Insert(as_const(snapshot).begin(), as_const(snapshot)[1]);
+                assert(snapshot.GetSize() == 102 && snapshot[0] == snapshot[101]);
+            });
+        }
+        for (thread& writer : writers) {
+            writer.join();
+        }
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestConcurrentSimpleVector() {
+    cout << "Test concurrent simple vector"s << endl;
+    constexpr size_t kThreads = 4;
+    constexpr size_t kPerThread = 20'000;
+    ConcurrentSimpleVector<size_t, 16> v;
+    const size_t& first = v[v.PushBack(size_t{0})];
+
+    atomic<bool> done{false};
+    // читатель сверяет опубликованные элементы, пока писатели добавляют
+    thread reader([&] {
+        while (!done.load()) {
+            const size_t size = v.GetSize();
+            for (size_t i = 0; i < size; i += 97) {
+                if (v.IsPublished(i)) {
+                    assert(v[i] % kPerThread < kPerThread);
+                }
+            }
+        }
+    });
+    SimpleVector<thread> writers;
+    for (size_t t = 0; t < kThreads; ++t) {
+        writers.EmplaceBack([&v, t] {
+            for (size_t i = 0; i < kPerThread; ++i) {
+                const size_t index = v.EmplaceBack(t * kPerThread + i);
+                assert(v.IsPublished(index) && v[index] == t * kPerThread + i);
+            }
+        });
+    }
+    for (thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    // элементы не перемещались
+    assert(&v[0] == &first);
+    assert(v.GetSize() == kThreads * kPerThread + 1 && !v.IsPublished(v.GetSize()));
+    SimpleVector<size_t> frozen = v.Freeze();
+    assert(v.IsEmpty() && frozen.GetSize() == kThreads * kPerThread + 1);
+    sort(frozen.begin(), frozen.end());
+    for (size_t i = 1; i < frozen.GetSize(); ++i) {
+        assert(frozen[i] == i - 1);
+    }
+
+    // индекс с неудавшимся конструктором пропускается
+    ConcurrentSimpleVector<ThrowingCopy> throwing;
+    throwing.EmplaceBack(1);
+    ThrowingCopy::copies_left = 0;
+    bool thrown = false;
+    try {
+        throwing.PushBack(throwing[0]);
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    ThrowingCopy::copies_left = -1;
+    throwing.EmplaceBack(3);
+    assert(thrown && throwing.GetSize() == 3 && !throwing.IsPublished(1) && throwing.IsPublished(2));
+    SimpleVector<ThrowingCopy> frozen_throwing = throwing.Freeze();
+    assert(frozen_throwing.GetSize() == 2 && frozen_throwing[1].GetValue() == 3);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSegmentedSimpleVector() {
+    cout << "Test segmented simple vector"s << endl;
+    SegmentedSimpleVector<int, 8> v;
+    v.PushBack(0);
+    const int* first = &v[0];
+    for (int i = 1; i < 100; ++i) {
+        v.PushBack(i);
+    }
+    // рост добавляет сегменты, не перемещая элементы
+    assert(&v[0] == first);
+    assert(v.GetSize() == 100 && v.GetCapacity() == 104);
+    for (size_t i = 0; i < v.GetSize(); ++i) {
+        assert(v[i] == static_cast<int>(i));
+    }
+    assert(equal(v.begin(), v.end(), SegmentedSimpleVector<int, 8>(v).begin()));
+    assert(v.end() - v.begin() == 100 && *(v.begin() + 42) == 42 && v.cbegin()[99] == 99);
+    try {
+        v.At(100);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // куски обходятся по порядку и не длиннее сегмента
+    size_t chunks = 0;
+    long long sum = 0;
+    v.ForEachSegment([&](const int* begin, const int* end) {
+        assert(end - begin <= 8);
+        sum += accumulate(begin, end, 0LL);
+        ++chunks;
+    });
+    assert(chunks == 13 && sum == 99 * 100 / 2);
+
+    // Clear сохраняет сегменты, ShrinkToFit отдаёт лишние
+    v.Resize(10);
+    assert(v.GetSize() == 10 && v.GetCapacity() == 104);
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 16);
+    v.Clear();
+    assert(v.IsEmpty() && v.GetCapacity() == 16);
+
+    SegmentedSimpleVector<int, 8> a{1, 2, 3};
+    SegmentedSimpleVector<int, 8> b{1, 2, 4};
+    assert(a != b && a < b && b >= a);
+    b = a;
+    assert(a == b);
+    SegmentedSimpleVector<int, 8> moved(std::move(b));
+    assert(b.IsEmpty() && moved == a);
+
+    // время жизни элементов
+    {
+        SegmentedSimpleVector<Counted, 4> counted;
+        for (int i = 0; i < 10; ++i) {
+            counted.EmplaceBack(i);
+        }
+        counted.PushBack(counted[3]);
+        assert(Counted::alive == 11 && counted[10].GetValue() == 3);
+        counted.PopBack();
+        assert(Counted::alive == 10);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSoASimpleVector() {
+    cout << "Test SoA simple vector"s << endl;
+    SoASimpleVector<double, int, string> v;
+    for (int i = 0; i < 100; ++i) {
+        v.PushBack(i * 0.5, i, to_string(i));
+    }
+    assert(v.GetSize() == 100 && v.GetCapacity() >= 100);
+
+    // столбцы непрерывны и делят общий размер
+    SimpleVectorView<double> xs = v.Column<0>();
+    SimpleVectorView<int> ids = v.Column<1>();
+    assert(xs.GetSize() == 100 && ids.GetSize() == 100);
+    assert(accumulate(ids.begin(), ids.end(), 0) == 99 * 100 / 2);
+    assert(&xs[1] == &xs[0] + 1);
+
+    // строка - кортеж ссылок на поля
+    auto [x, id, name] = v[42];
+    assert(x == 21.0 && id == 42 && name == "42"s);
+    get<1>(v[42]) = -1;
+    assert(ids[42] == -1);
+    int visited = 0;
+    for (auto [row_x, row_id, row_name] : v) {
+        row_x += 1.0;
+        assert(row_id == -1 || row_name == to_string(row_id));
+        ++visited;
+    }
+    assert(visited == 100 && v.Column<0>()[0] == 1.0);
+    assert((v.end() - v.begin()) == 100 && get<2>(*(v.cbegin() + 7)) == "7"s);
+
+    // строка может ссылаться на сам вектор, даже если он растёт
+    v.Reserve(v.GetSize());
+    v.EmplaceBack(get<0>(v[0]), get<1>(v[1]), get<2>(v[2]));
+    assert(get<0>(v[100]) == 1.0 && get<1>(v[100]) == 1 && get<2>(v[100]) == "2"s);
+
+    SoASimpleVector<double, int, string> copy(v);
+    assert(copy == v);
+    v.PopBack();
+    assert(copy != v && v.GetSize() == 100);
+    v.Resize(3);
+    assert(v.GetSize() == 3 && v.Column<2>().GetSize() == 3);
+    v.Resize(5);
+    assert(get<0>(v[4]) == 0.0 && get<1>(v[4]) == 0 && get<2>(v[4]).empty());
+    try {
+        v.At(5);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // сбой копирования одного столбца при росте не трогает другие
+    SoASimpleVector<string, ThrowingCopy> strong;
+    for (int i = 0; i < 4; ++i) {
+        strong.PushBack("long string to defeat small buffer #"s + to_string(i), ThrowingCopy(i));
+    }
+    strong.Reserve(4);
+    const size_t capacity = strong.GetCapacity();
+    ThrowingCopy::copies_left = 2;
+    bool thrown = false;
+    try {
+        strong.Reserve(capacity + 1);
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    ThrowingCopy::copies_left = -1;
+    assert(thrown && strong.GetCapacity() == capacity && strong.GetSize() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(get<0>(strong[i]) == "long string to defeat small buffer #"s + to_string(i));
+        assert(get<1>(strong[i]).GetValue() == i);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestFlatContainers() {
+    cout << "Test flat set and flat map"s << endl;
+    // нижняя граница без ветвлений совпадает с std::lower_bound
+    SimpleVector<int> sorted;
+    for (int i = 0; i < 50; ++i) {
+        sorted.PushBack(i / 3 * 2);
+    }
+    for (int key = -1; key < 40; ++key) {
+        for (size_t size = 0; size <= sorted.GetSize(); ++size) {
+            assert(BranchlessLowerBound(sorted.cbegin(), size, key, less<int>())
+                   == lower_bound(sorted.cbegin(), sorted.cbegin() + size, key));
+        }
+    }
+
+    FlatSet<int> set{5, 1, 3, 3, 9};
+    assert(set.GetSize() == 4 && is_sorted(set.begin(), set.end()));
+    assert(set.Contains(3) && !set.Contains(4) && set.Count(9) == 1);
+    assert(set.Insert(4).second && !set.Insert(4).second && *set.Find(4) == 4);
+    assert(*set.LowerBound(6) == 9 && *set.UpperBound(5) == 9);
+    assert(set.Erase(1) == 1 && set.Erase(1) == 0);
+
+    // набор вливается одним слиянием, повторы отбрасываются
+    set.Reserve(16);
+    const int* data = set.begin();
+    const SimpleVector<int> batch{2, 3, 6, 10, 10};
+    set.InsertSorted(batch);
+    set.InsertSorted(batch.begin(), batch.begin());
+    assert(set.begin() == data);
+    assert((set.GetVector() == SimpleVector<int>{2, 3, 4, 5, 6, 9, 10}));
+    set.InsertSorted(SimpleVector<int>{8, 7, 0});
+    assert((set.GetVector() == SimpleVector<int>{0, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+
+    // сравнение множеств позволяет делать их ключами
+    FlatSet<FlatSet<int>> nested{FlatSet<int>{1, 2}, FlatSet<int>{1}, FlatSet<int>{1, 2}};
+    assert(nested.GetSize() == 2 && nested.begin()->GetSize() == 1);
+    FlatSet<int, greater<int>> descending{1, 3, 2};
+    assert(*descending.begin() == 3);
+
+    FlatMap<string, int> map{{"b"s, 2}, {"a"s, 1}, {"b"s, 20}};
+    assert(map.GetSize() == 2 && map.At("b"s) == 2 && map.begin()->first == "a"s);
+    map["c"s] += 3;
+    assert(map["c"s] == 3 && map.GetSize() == 3);
+    assert(!map.Insert({"a"s, 100}).second && map.At("a"s) == 1);
+    assert(!map.InsertOrAssign("a"s, 100).second && map.At("a"s) == 100);
+    assert(map.TryEmplace("d"s, 4).second && map.Contains("d"s));
+    try {
+        map.At("z"s);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    // при слиянии остаётся бывшее в словаре значение, затем первое из набора
+    map.InsertSorted(SimpleVector<pair<string, int>>{{"e"s, 5}, {"a"s, -1}, {"e"s, 50}});
+    assert(map.GetSize() == 5 && map.At("a"s) == 100 && map.At("e"s) == 5);
+    assert(map.Erase("c"s) == 1 && !map.Contains("c"s));
+    FlatMap<string, int> copy = map;
+    assert(copy == map);
+    copy["a"s] = 0;
+    assert(copy < map);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSimpleDeque() {
+    cout << "Test simple deque"s << endl;
+    SimpleDeque<int> d;
+    for (int i = 0; i < 5; ++i) {
+        d.PushBack(i);
+        d.PushFront(-i - 1);
+    }
+    // -5 -4 -3 -2 -1 0 1 2 3 4
+    assert(d.GetSize() == 10 && d.GetCapacity() == 16);
+    for (int i = 0; i < 10; ++i) {
+        assert(d[i] == i - 5);
+    }
+    assert(is_sorted(d.begin(), d.end()) && d.end() - d.begin() == 10);
+
+    // очередь переходит через конец буфера и занимает два куска
+    for (int i = 0; i < 12; ++i) {
+        d.PopFront();
+        d.PushBack(5 + i);
+    }
+    assert(d.GetSize() == 10 && d.GetCapacity() == 16 && d[0] == 7 && d.At(9) == 16);
+    assert(!d.SecondSpan().IsEmpty());
+    assert(d.FirstSpan().GetSize() + d.SecondSpan().GetSize() == d.GetSize());
+    int expected = 7;
+    for (SimpleVectorView<int> span : {d.FirstSpan(), d.SecondSpan()}) {
+        for (int value : span) {
+            assert(value == expected++);
+        }
+    }
+
+    // перевыделение укладывает элементы одним куском
+    d.Reserve(17);
+    assert(d.GetCapacity() == 32 && d.SecondSpan().IsEmpty() && d.FirstSpan().GetSize() == 10);
+    assert(d.FirstSpan()[0] == 7 && d.FirstSpan()[9] == 16);
+    // ёмкость больше 2^63 не округлить до степени двойки
+    try {
+        d.Reserve(numeric_limits<size_t>::max());
+        assert(false);
+    } catch (const length_error&) {
+        assert(d.GetCapacity() == 32 && d.GetSize() == 10);
+    }
+    try {
+        d.At(10);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    while (!d.IsEmpty()) {
+        d.PopBack();
+    }
+    assert(d.FirstSpan().begin() == d.SecondSpan().begin());
+
+    SimpleDeque<int> a{1, 2, 3};
+    SimpleDeque<int> b = a;
+    assert(a == b);
+    b.PopFront();
+    b.PushFront(0);
+    assert(b != a && b < a);
+
+    // аргумент может ссылаться на элемент самой очереди при переполнении
+    SimpleDeque<string> strings{"first"s, "second"s};
+    assert(strings.GetCapacity() == 2);
+    strings.PushFront(strings[1]);
+    strings.PushBack(strings[0]);
+    assert(strings[0] == "second"s && strings[3] == "second"s && strings[1] == "first"s);
+
+    // некопируемые элементы переносятся перемещением
+    SimpleDeque<X> movable;
+    for (size_t i = 0; i < 5; ++i) {
+        movable.EmplaceFront(i);
+    }
+    assert(movable[0].GetX() == 4 && movable[4].GetX() == 0);
+
+    // сбой копирования при росте оставляет очередь как была
+    SimpleDeque<ThrowingCopy> strong;
+    for (int i = 0; i < 4; ++i) {
+        strong.EmplaceBack(i);
+    }
+    strong.PopFront();
+    strong.EmplaceBack(4);
+    ThrowingCopy::copies_left = 2;
+    bool thrown = false;
+    try {
+        strong.EmplaceFront(-1);
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    ThrowingCopy::copies_left = -1;
+    assert(thrown && strong.GetSize() == 4 && strong.GetCapacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(strong[i].GetValue() == i + 1);
+    }
+
+    {
+        SimpleDeque<Counted> counted;
+        for (int i = 0; i < 7; ++i) {
+            counted.EmplaceBack(i);
+            counted.EmplaceFront(i);
+        }
+        counted.PopFront();
+        counted.PopBack();
+        assert(Counted::alive == 12);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+#if __cplusplus >= 202002L
+// Таблица квадратов, построенная на этапе компиляции
+constexpr StaticSimpleVector<int, 16> MakeSquares() {
+    StaticSimpleVector<int, 16> squares;
+    for (int i = 0; i < 10; ++i) {
+        squares.PushBack(i * i);
+    }
+    squares.Erase(squares.begin());
+    squares.Insert(squares.begin(), 0);
+    return squares;
+}
+
+// Временный SimpleVector должен освободить память до конца вычисления
+constexpr int SumOfEvens(int n) {
+    SimpleVector<int> v;
+    for (int i = 0; i < n; ++i) {
+        v.PushBack(i);
+    }
+    EraseIf(v, [](int x) {
+        return x % 2 != 0;
+    });
+    v.Insert(v.begin(), 3, 0);
+    int sum = 0;
+    for (int x : v) {
+        sum += x;
+    }
+    return sum + static_cast<int>(v.Count(0));
+}
+
+constexpr bool ConstexprStrings() {
+    SimpleVector<std::string> v{"b"s, "c"s};
+    v.Insert(v.begin(), "a"s);
+    v.Reserve(10);
+    SimpleVector<std::string> copy = v;
+    return copy == v && v.GetSize() == 3 && v[0] == "a"s && v.Find("c"s) == v.begin() + 2;
+}
+#endif
+
+void TestStaticSimpleVector() {
+    cout << "Test static simple vector"s << endl;
+    StaticSimpleVector<int, 4> v{1, 2};
+    static_assert(StaticSimpleVector<int, 4>::GetCapacity() == 4);
+    assert(v.GetSize() == 2 && !v.IsFull());
+    v.Insert(v.begin() + 1, 5);
+    assert(v.TryEmplaceBack(7) != nullptr && v.IsFull());
+    assert((v == StaticSimpleVector<int, 4>{1, 5, 2, 7}));
+    // переполнение: TryEmplaceBack не бросает исключений, PushBack бросает
+    assert(v.TryEmplaceBack(8) == nullptr && v.GetSize() == 4);
+    try {
+        v.PushBack(8);
+        assert(false);
+    } catch (const length_error&) {
+    }
+    try {
+        v.Insert(v.begin(), 2, 0);
+        assert(false);
+    } catch (const length_error&) {
+    }
+    v.Erase(v.begin(), v.begin() + 2);
+    assert((v == StaticSimpleVector<int, 4>{2, 7}) && v.At(1) == 7);
+    v.Resize(4);
+    assert(v[3] == 0 && v.Count(0) == 2);
+
+    StaticSimpleVector<string, 8> strings(2, "x"s);
+    const string words[] = {"a"s, "b"s, "c"s};
+    strings.Insert(strings.begin() + 1, begin(words), end(words));
+    strings.Emplace(strings.end(), 3, 'z');
+    assert(strings.GetSize() == 6 && strings[1] == "a"s && strings[5] == "zzz"s);
+    strings.Erase(strings.begin());
+    StaticSimpleVector<string, 8> other{"q"s};
+    strings.swap(other);
+    assert(strings.GetSize() == 1 && other.GetSize() == 5 && other[0] == "a"s);
+    StaticSimpleVector<string, 8> moved = std::move(other);
+    assert(other.IsEmpty() && moved.Contains("zzz"s) && moved < strings);
+
+    {
+        StaticSimpleVector<Counted, 8> counted;
+        for (int i = 0; i < 6; ++i) {
+            counted.EmplaceBack(i);
+        }
+        counted.Erase(counted.begin() + 1);
+        counted.PopBack();
+        StaticSimpleVector<Counted, 8> copy = counted;
+        assert(Counted::alive == 8);
+    }
+    assert(Counted::alive == 0);
+
+#if __cplusplus >= 202002L
+    constexpr auto kSquares = MakeSquares();
+    static_assert(kSquares.GetSize() == 10 && kSquares[0] == 0 && kSquares[9] == 81);
+    static_assert(SumOfEvens(10) == 24);
+    static_assert(ConstexprStrings());
+    assert(kSquares.Count(49) == 1);
+#endif
+    cout << "Done!"s << endl << endl;
+}
+
+// Выполняет action в дочернем процессе; истина, если тот остановлен сигналом
+template <typename Action>
+bool DiesBySignal(Action action) {
+    cout.flush();
+    const pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        // сообщение режима Debug не должно попасть в вывод тестов
+        static_cast<void>(freopen("/dev/null", "w", stderr));
+        action();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFSIGNALED(status);
+}
+
+void TestBoundsCheck() {
+    cout << "Test bounds check"s << endl;
+    SimpleVector<int> v{1, 2, 3};
+    SmallSimpleVector<int, 2> small{1, 2, 3};
+    StaticSimpleVector<int, 4> fixed{1, 2, 3};
+    assert(v[2] == 3 && small[2] == 3 && fixed[2] == 3);
+    // At бросает исключение в любом режиме
+    try {
+        v.At(3);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    if constexpr (kCheckMode != CheckMode::Unchecked) {
+        assert(DiesBySignal([&] {
+            static_cast<void>(v[3]);
+        }));
+        assert(DiesBySignal([&] {
+            v.Insert(v.begin() + 4, 0);
+        }));
+        assert(DiesBySignal([&] {
+            v.Erase(v.end());
+        }));
+        assert(DiesBySignal([&] {
+            v.Erase(v.begin() + 2, v.begin() + 1);
+        }));
+        assert(DiesBySignal([] {
+            SimpleVector<int> empty;
+            empty.PopBack();
+        }));
+        assert(DiesBySignal([&] {
+            static_cast<void>(small[5]);
+        }));
+        assert(DiesBySignal([&] {
+            fixed.Erase(fixed.end());
+        }));
+        // остальные контейнеры и представления проверяются так же
+        assert(DiesBySignal([&] {
+            static_cast<void>(SimpleVectorView<int>(v)[3]);
+        }));
+        assert(DiesBySignal([] {
+            SimpleDeque<int> deque;
+            deque.PopFront();
+        }));
+        assert(DiesBySignal([] {
+            SegmentedSimpleVector<int> segmented{1, 2};
+            static_cast<void>(segmented[2]);
+        }));
+    }
+    if constexpr (kCheckMode == CheckMode::Debug) {
+        // вставка части самого вектора нарушает предусловие Insert
+        assert(DiesBySignal([&] {
+            v.Insert(v.begin(), v.begin(), v.begin() + 2);
+        }));
+    }
+    // в родительском процессе вектор не изменился
+    assert((v == SimpleVector<int>{1, 2, 3}));
+    cout << "Done!"s << endl << endl;
+}
+
+#ifdef __linux__
+void TestHugePageAllocator() {
+    cout << "Test huge page allocator"s << endl;
+    HugePageOptions options;
+    options.threshold = 1 << 16;
+    HugePageSimpleVector<float> v{HugePageAllocator<float>(options)};
+    for (int i = 0; i < 1000; ++i) {
+        v.PushBack(static_cast<float>(i));
+    }
+    // меньше порога: обычная куча
+    assert(v.GetCapacity() * sizeof(float) < options.threshold);
+
+    // отображение выровнено на huge page, чтобы ядро могло собрать прозрачные huge pages
+    v.Reserve(1 << 20);
+    assert(reinterpret_cast<uintptr_t>(v.begin()) % kHugePageSize == 0);
+    for (int i = 1000; i < (1 << 20); ++i) {
+        v.PushBack(static_cast<float>(i));
+    }
+    // рост mremap сохраняет элементы без копирования
+    v.Reserve(3 << 20);
+    assert(v.GetCapacity() == (3 << 20));
+    assert(reinterpret_cast<uintptr_t>(v.begin()) % kHugePageSize == 0);
+    v.PushBack(-1.0f);
+    assert(v[0] == 0.0f && v[(1 << 20) - 1] == static_cast<float>((1 << 20) - 1) && v[1 << 20] == -1.0f);
+
+    // копия наследует параметры аллокатора
+    HugePageSimpleVector<float> copy = v;
+    assert(copy == v && copy.GetAllocator() == v.GetAllocator());
+
+    // отображение, которому некуда расти на месте, переносится без потери выравнивания
+    {
+        HugePageSimpleVector<float> first{HugePageAllocator<float>(options)};
+        HugePageSimpleVector<float> second{HugePageAllocator<float>(options)};
+        for (int round = 1; round <= 4; ++round) {
+            const size_t old_size = first.GetSize();
+            first.Resize(static_cast<size_t>(round) << 20);
+            second.Resize(static_cast<size_t>(round) << 20);
+            fill(first.begin() + old_size, first.end(), static_cast<float>(round));
+            fill(second.begin() + old_size, second.end(), static_cast<float>(-round));
+            assert(reinterpret_cast<uintptr_t>(first.begin()) % kHugePageSize == 0);
+            assert(reinterpret_cast<uintptr_t>(second.begin()) % kHugePageSize == 0);
+        }
+        assert(first[0] == 1.0f && first[(4 << 20) - 1] == 4.0f && second[0] == -1.0f && second[(4 << 20) - 1] == -4.0f);
+    }
+
+    // сжатие ниже порога возвращает буфер в обычную кучу
+    v.Resize(500);
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 500 && v[499] == 499.0f);
+
+    // без пула huge pages MAP_HUGETLB заменяется прозрачными huge pages,
+    // а привязка к узлу 0 доступна на любой системе с NUMA
+    HugePageOptions bound;
+    bound.threshold = 0;
+    bound.mode = HugePageMode::kHugeTlb;
+    bound.numa = NumaPolicy::kBind;
+    bound.node_mask = 1;
+    HugePageSimpleVector<uint64_t> nodes{HugePageAllocator<uint64_t>(bound)};
+    nodes.Resize(1 << 18);
+    iota(nodes.begin(), nodes.end(), 0);
+    nodes.Reserve(1 << 20);
+    assert(nodes[(1 << 18) - 1] == (1 << 18) - 1);
+    assert(v.GetAllocator() != nodes.GetAllocator());
+
+    // несуществующий узел NUMA: буфер не выделяется
+    bound.node_mask = 1ul << 63;
+    HugePageSimpleVector<uint64_t> invalid{HugePageAllocator<uint64_t>(bound)};
+    bool thrown = false;
+    try {
+        invalid.Reserve(1);
+    } catch (const system_error&) {
+        thrown = true;
+    }
+    assert(thrown && invalid.GetCapacity() == 0);
+    cout << "Done!"s << endl << endl;
+}
+#endif
+
+void TestStreamingAlgorithms() {
+    cout << "Test streaming algorithms"s << endl;
+    // невыровненные начала и длины проходят через голову, тело и хвост ядер
+    alignas(64) uint16_t buffer[300];
+    alignas(64) uint16_t copy[300];
+    for (size_t offset = 0; offset < 5; ++offset) {
+        for (size_t size : {0, 1, 15, 16, 17, 64, 129, 250}) {
+            fill(begin(buffer), end(buffer), uint16_t{7});
+            StreamingFill(buffer + offset, size, uint16_t{0xBEEF});
+            assert(count(buffer, buffer + 300, uint16_t{0xBEEF}) == static_cast<ptrdiff_t>(size));
+            assert(count(buffer + offset, buffer + offset + size, uint16_t{0xBEEF}) == static_cast<ptrdiff_t>(size));
+
+            iota(begin(buffer), end(buffer), uint16_t{1});
+            fill(begin(copy), end(copy), uint16_t{0});
+            StreamingCopy(buffer + 3, size, copy + offset);
+            assert(equal(buffer + 3, buffer + 3 + size, copy + offset));
+            assert(count(begin(copy), end(copy), uint16_t{0}) == static_cast<ptrdiff_t>(300 - size));
+        }
+    }
+    // размер не делит 32 байта: обычный std::fill
+    struct Rgb {
+        uint8_t r, g, b;
+    };
+    Rgb pixels[100];
+    StreamingFill(pixels, 100, Rgb{1, 2, 3});
+    assert(all_of(begin(pixels), end(pixels), [](const Rgb& p) {
+        return p.r == 1 && p.g == 2 && p.b == 3;
+    }));
+
+    // шаблон заполнения собирается из байт: конструктор по умолчанию не нужен
+    struct Tagged {
+        explicit Tagged(int value)
+            : x(value) {
+        }
+        int x;
+    };
+    static_assert(kIsStreamingFillable<Tagged> && !is_default_constructible_v<Tagged>);
+    SimpleVector<Tagged> tagged(100, Tagged(0));
+    StreamingFill(tagged.begin() + 1, 90, Tagged(9));
+    ParallelFill(tagged.begin(), tagged.begin() + 1, Tagged(8));
+    assert(tagged[0].x == 8 && tagged[1].x == 9 && tagged[90].x == 9 && tagged[91].x == 0);
+
+    // элементы с const-полем создаются копированием, присваивание им не нужно
+    struct Fixed {
+        const int x;
+    };
+    SimpleVector<Fixed> fixed(3, Fixed{4});
+    const SimpleVector<Fixed> fixed_copy = fixed;
+    assert(fixed_copy.GetSize() == 3 && fixed_copy[2].x == 4);
+
+    SimpleVector<int> v{1, 2, 3, 4, 5};
+    v.Assign(3, v[4]);
+    assert((v == SimpleVector<int>{5, 5, 5}) && v.GetCapacity() == 5);
+    v.Assign(4, 1);
+    assert((v == SimpleVector<int>{1, 1, 1, 1}) && v.GetCapacity() == 5);
+    v.Assign(8, v[0]);
+    assert(v.GetSize() == 8 && v.GetCapacity() == 8 && v.Count(1) == 8);
+    v.Assign(0, 0);
+    assert(v.IsEmpty() && v.GetCapacity() == 8);
+
+    SimpleVector<string> strings{"a"s, "b"s};
+    strings.Assign(3, strings[1]);
+    assert((strings == SimpleVector<string>{"b"s, "b"s, "b"s}));
+    {
+        SimpleVector<Counted> counted;
+        counted.Assign(5, Counted(1));
+        counted.Assign(2, Counted(2));
+        assert(Counted::alive == 2 && counted[1].GetValue() == 2);
+    }
+    assert(Counted::alive == 0);
+
+    // буферы больше порогов: потоковые записи и деление между потоками
+    const size_t large = kParallelStreamingThreshold / sizeof(float) + 17;
+    SimpleVector<float> floats(large, 0.5f);
+    assert(floats.Count(0.5f) == large);
+    SimpleVector<float> floats_copy = floats;
+    assert(floats_copy == floats);
+    floats_copy.Assign(kStreamingThreshold / sizeof(float) + 3, 2.0f);
+    assert(floats_copy.Count(2.0f) == floats_copy.GetSize());
+
+    ParallelAssign(floats, large, 1.5f);
+    assert(floats.GetSize() == large && floats.Count(1.5f) == large);
+    iota(floats.begin(), floats.end(), 0.0f);
+    ParallelAssign(floats_copy, floats);
+    assert(floats_copy == floats);
+    ParallelAssign(strings, 2, "c"s);
+    assert((strings == SimpleVector<string>{"c"s, "c"s}));
+    cout << "Done!"s << endl << endl;
+}
+
+#ifdef SIMPLE_VECTOR_STATS
+void TestVectorStats() {
+    cout << "Test vector stats"s << endl;
+    struct Probe {
+        int value = 0;
+    };
+    VectorStats& stats = VectorStatsRegistry::For<Probe>();
+    {
+        SimpleVector<Probe> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(Probe{i});
+        }
+        v.Insert(v.begin(), Probe{42});
+        v.Erase(v.begin() + 1);
+        v.Reserve(100);
+    }
+    const VectorStatsSnapshot snapshot = stats.GetSnapshot();
+    // ёмкость 1, 2, 4, 8 и Reserve(100)
+    assert(snapshot.allocations == 5 && snapshot.reallocations == 4);
+    assert(snapshot.relocated_elements == 1 + 2 + 4 + 5);
+    assert(snapshot.shifted_elements == 5 + 4);
+    assert(snapshot.peak_capacity == 100);
+
+    ostringstream out;
+    VectorStatsRegistry::Instance().Dump(out);
+    assert(out.str().find("Probe: allocations=5 reallocations=4"s) != string::npos);
+    cout << "Done!"s << endl << endl;
+}
+#endif
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -159,5 +1910,40 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestRawStorage();
+    TestEmplace();
+    TestTriviallyRelocatable();
+    TestStrongExceptionGuarantee();
+    TestAllocator();
+    TestSmallSimpleVector();
+    TestGrowthPolicy();
+    TestRangeInsert();
+    TestRangeErase();
+    TestShrinkToFit();
+    TestDefaultInit();
+    TestSimdAlgorithms();
+    TestParallelAlgorithms();
+    TestAlignedStorage();
+#ifdef __linux__
+    TestMappedFile();
+#endif
+    TestSerialization();
+    TestAdoptRelease();
+    TestSimpleVectorView();
+    TestCowSimpleVector();
+    TestConcurrentSimpleVector();
+    TestSegmentedSimpleVector();
+    TestSoASimpleVector();
+    TestFlatContainers();
+    TestSimpleDeque();
+    TestStaticSimpleVector();
+    TestBoundsCheck();
+#ifdef __linux__
+    TestHugePageAllocator();
+#endif
+    TestStreamingAlgorithms();
+#ifdef SIMPLE_VECTOR_STATS
+    TestVectorStats();
+#endif
     return 0;
 }
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include "array_ptr.h"
+#include "simple_vector.h"
+
+// Хранилище SimpleVector в файле, отображённом в память (POSIX mmap, MAP_SHARED).
+// Открытие существующего файла не читает его: страницы подгружаются по обращению.
+// Рост идёт через ftruncate и mremap, без копирования элементов.
+
+enum class MappedAccess {
+    kNormal,
+    kSequential,
+    kRandom,
+    kWillNeed,
+};
+
+struct MappedFileOptions {
+    // MAP_POPULATE: подгрузить все страницы сразу при отображении
+    bool populate = false;
+    // Подсказка ядру (madvise) о порядке доступа
+    MappedAccess access = MappedAccess::kNormal;
+};
+
+// Файл с единственным отображением от начала. Длина файла не меньше отображения.
+// Sync фиксирует длину данных: при закрытии файл обрезается до неё, так что
+// элементы, добавленные после последнего Sync, на диске не остаются.
+class MappedFile {
+public:
+    // Открывает или создаёт файл; отображение создаётся первым Map
+    static std::shared_ptr<MappedFile> Open(const std::string& path, const MappedFileOptions& options = {}) {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            ThrowSystemError("open " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat " + path);
+        }
+        return std::shared_ptr<MappedFile>(new MappedFile(fd, static_cast<size_t>(info.st_size), options));
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        Unmap();
+        // ошибки при закрытии сообщить некому
+        [[maybe_unused]] const int truncated = ::ftruncate(fd_, static_cast<off_t>(committed_));
+        ::close(fd_);
+    }
+
+    // Длина данных, зафиксированная при открытии или последним Sync
+    size_t GetCommittedSize() const noexcept {
+        return committed_;
+    }
+
+    void* GetData() const noexcept {
+        return data_;
+    }
+
+    size_t GetMappedSize() const noexcept {
+        return mapped_;
+    }
+
+    void* Map(size_t bytes) {
+        assert(bytes != 0);
+        if (data_) {
+            throw std::logic_error("MappedFile supports a single mapping");
+        }
+        EnsureFileSize(bytes);
+        int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        if (options_.populate) {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        void* data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, fd_, 0);
+        if (data == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        data_ = data;
+        mapped_ = bytes;
+        Advise();
+        return data_;
+    }
+
+    // Меняет размер отображения; прежний адрес после успешного вызова недействителен
+    void* Remap(size_t bytes) {
+        assert(data_ && bytes != 0);
+        EnsureFileSize(bytes);
+#ifdef MREMAP_MAYMOVE
+        void* data = ::mremap(data_, mapped_, bytes, MREMAP_MAYMOVE);
+        if (data == MAP_FAILED) {
+            ThrowSystemError("mremap");
+        }
+        data_ = data;
+        mapped_ = bytes;
+#else
+        // данные лежат в файле, поэтому отображение можно просто пересоздать
+        Unmap();
+        Map(bytes);
+#endif
+        Advise();
+        return data_;
+    }
+
+    void Unmap() noexcept {
+        if (data_) {
+            ::munmap(data_, mapped_);
+            data_ = nullptr;
+            mapped_ = 0;
+        }
+    }
+
+    // Сбрасывает первые bytes байт на диск и фиксирует их как длину данных
+    void Sync(size_t bytes) {
+        assert(bytes <= mapped_ || (bytes == 0 && !data_));
+        if (bytes != 0 && ::msync(data_, bytes, MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+        committed_ = bytes;
+    }
+
+private:
+    MappedFile(int fd, size_t file_size, const MappedFileOptions& options) noexcept
+        : fd_(fd),
+          file_size_(file_size),
+          committed_(file_size),
+          options_(options) {
+    }
+
+    [[noreturn]] static void ThrowSystemError(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void EnsureFileSize(size_t bytes) {
+        if (bytes > file_size_) {
+            if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+                ThrowSystemError("ftruncate");
+            }
+            file_size_ = bytes;
+        }
+    }
+
+    void Advise() noexcept {
+        int advice = MADV_NORMAL;
+        switch (options_.access) {
+            case MappedAccess::kSequential:
+                advice = MADV_SEQUENTIAL;
+                break;
+            case MappedAccess::kRandom:
+                advice = MADV_RANDOM;
+                break;
+            case MappedAccess::kWillNeed:
+                advice = MADV_WILLNEED;
+                break;
+            default:
+                break;
+        }
+        // подсказка необязательна, её ошибка не мешает работе
+        ::madvise(data_, mapped_, advice);
+    }
+
+    int fd_;
+    void* data_ = nullptr;
+    size_t mapped_ = 0;
+    size_t file_size_;
+    size_t committed_;
+    MappedFileOptions options_;
+};
+
+// Аллокатор над MappedFile: единственный буфер контейнера — это отображение файла.
+// Без файла (например, у копии вектора) память выделяется std::allocator.
+// Второй одновременный буфер над файлом невозможен, поэтому операции, которым он
+// нужен (копирующее присваивание в вектор над файлом), бросают std::logic_error.
+template <typename Type>
+class MappedFileAllocator {
+    static_assert(std::is_trivially_copyable_v<Type>, "file-backed elements must be trivially copyable");
+
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    MappedFileAllocator() noexcept = default;
+
+    explicit MappedFileAllocator(std::shared_ptr<MappedFile> file) noexcept
+        : file_(std::move(file)) {
+    }
+
+    template <typename Other>
+    MappedFileAllocator(const MappedFileAllocator<Other>& other) noexcept
+        : file_(other.GetFile()) {
+    }
+
+    // Копия вектора над файлом живёт в обычной памяти
+    MappedFileAllocator select_on_container_copy_construction() const noexcept {
+        return MappedFileAllocator();
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        if (!file_) {
+            return std::allocator<Type>().allocate(size);
+        }
+        return static_cast<Type*>(file_->Map(size * sizeof(Type)));
+    }
+
+    void deallocate(Type* ptr, size_t size) noexcept {
+        if (!file_) {
+            std::allocator<Type>().deallocate(ptr, size);
+        } else {
+            assert(ptr == file_->GetData());
+            file_->Unmap();
+        }
+    }
+
+    Type* reallocate(Type* ptr, size_t old_size, size_t new_size) {
+        if (!file_) {
+            Type* new_ptr = std::allocator<Type>().allocate(new_size);
+            std::memcpy(static_cast<void*>(new_ptr), ptr, std::min(old_size, new_size) * sizeof(Type));
+            std::allocator<Type>().deallocate(ptr, old_size);
+            return new_ptr;
+        }
+        assert(ptr == file_->GetData());
+        return static_cast<Type*>(file_->Remap(new_size * sizeof(Type)));
+    }
+
+    const std::shared_ptr<MappedFile>& GetFile() const noexcept {
+        return file_;
+    }
+
+private:
+    std::shared_ptr<MappedFile> file_;
+};
+
+template <typename Type, typename Other>
+bool operator==(const MappedFileAllocator<Type>& lhs, const MappedFileAllocator<Other>& rhs) noexcept {
+    return lhs.GetFile() == rhs.GetFile();
+}
+
+template <typename Type, typename Other>
+bool operator!=(const MappedFileAllocator<Type>& lhs, const MappedFileAllocator<Other>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+using MappedSimpleVector = SimpleVector<Type, MappedFileAllocator<Type>, GrowthPolicy>;
+
+// Открывает вектор над файлом за O(1): его элементы — текущее содержимое файла
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+MappedSimpleVector<Type, GrowthPolicy> OpenMappedVector(const std::string& path,
+                                                        const MappedFileOptions& options = {}) {
+    MappedFileAllocator<Type> alloc(MappedFile::Open(path, options));
+    const size_t bytes = alloc.GetFile()->GetCommittedSize();
+    if (bytes % sizeof(Type) != 0) {
+        throw std::runtime_error("file size of " + path + " is not a multiple of the element size");
+    }
+    const size_t size = bytes / sizeof(Type);
+    if (size == 0) {
+        return MappedSimpleVector<Type, GrowthPolicy>(alloc);
+    }
+    ArrayPtr<Type, MappedFileAllocator<Type>> storage(alloc.allocate(size), size, alloc);
+    return MappedSimpleVector<Type, GrowthPolicy>(std::move(storage), size);
+}
+
+// Сбрасывает элементы на диск и фиксирует размер вектора как длину файла
+template <typename Type, typename GrowthPolicy>
+void Sync(const MappedSimpleVector<Type, GrowthPolicy>& vector) {
+    if (const std::shared_ptr<MappedFile> file = vector.GetAllocator().GetFile()) {
+        file->Sync(vector.GetSize() * sizeof(Type));
+    }
+}
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include "simple_vector.h"
+#include "streaming_algorithms.h"
+#include "work_stealing_pool.h"
+
+// Параллельные алгоритмы над непрерывными диапазонами и SimpleVector.
+// Диапазон делится на куски по grain_size элементов, которые выполняет
+// WorkStealingPool. Границы кусков выровнены на кеш-линию, чтобы соседние
+// задачи не писали в одну линию (false sharing). Функции вызываются
+// одновременно из разных потоков и должны это допускать.
+
+inline constexpr size_t kParallelCacheLine = 64;
+
+// Нижняя граница автоматически подобранного размера куска
+inline constexpr size_t kParallelMinGrain = 2048;
+
+// С этого размера в байтах ParallelFill и ParallelCopy делят работу между потоками:
+// одному потоку не хватает пропускной способности памяти. Меньшие буферы
+// обрабатывает вызывающий поток (FillRange, CopyRange).
+inline constexpr size_t kParallelStreamingThreshold = size_t{64} << 20;
+
+struct ParallelOptions {
+    // Элементов в одной задаче; 0 — подбирается по числу потоков пула
+    size_t grain_size = 0;
+    // nullptr — WorkStealingPool::Default()
+    WorkStealingPool* pool = nullptr;
+};
+
+inline WorkStealingPool& PoolFor(const ParallelOptions& options) {
+    return options.pool ? *options.pool : WorkStealingPool::Default();
+}
+
+// Разбиение [0, size) на count кусков: первый удлинён на head элементов до
+// выровненного адреса, остальные начинаются с границы кеш-линии
+struct ChunkLayout {
+    size_t size = 0;
+    size_t head = 0;
+    size_t grain = 1;
+    size_t count = 0;
+
+    size_t Begin(size_t chunk) const noexcept {
+        return chunk == 0 ? 0 : std::min(size, head + chunk * grain);
+    }
+
+    size_t End(size_t chunk) const noexcept {
+        return std::min(size, head + (chunk + 1) * grain);
+    }
+};
+
+template <typename Type>
+ChunkLayout MakeChunkLayout(const Type* first, size_t size, const ParallelOptions& options, size_t thread_count) {
+    ChunkLayout layout;
+    layout.size = size;
+    if (size == 0) {
+        return layout;
+    }
+    size_t grain = options.grain_size;
+    if (grain == 0) {
+        // по несколько кусков на поток, чтобы кражей выровнять неравномерную нагрузку
+        grain = std::max(kParallelMinGrain, size / ((thread_count + 1) * 4));
+    }
+    if constexpr (kParallelCacheLine % sizeof(Type) == 0) {
+        constexpr size_t kLine = kParallelCacheLine / sizeof(Type);
+        grain = (grain + kLine - 1) / kLine * kLine;
+        const size_t misalignment = reinterpret_cast<uintptr_t>(first) % kParallelCacheLine;
+        if (misalignment % sizeof(Type) == 0) {
+            layout.head = (kParallelCacheLine - misalignment) % kParallelCacheLine / sizeof(Type);
+        }
+    }
+    layout.grain = grain;
+    layout.count = size <= layout.head + grain ? 1 : 1 + (size - layout.head - 1) / grain;
+    return layout;
+}
+
+// Вызывает body(chunk, chunk_first, chunk_last) для каждого куска [first, last)
+template <typename Type, typename Body>
+void ParallelChunks(Type* first, Type* last, const ParallelOptions& options, const Body& body) {
+    WorkStealingPool& pool = PoolFor(options);
+    const ChunkLayout layout = MakeChunkLayout(first, static_cast<size_t>(last - first), options, pool.GetThreadCount());
+    pool.Run(layout.count, [&](size_t chunk) {
+        body(chunk, first + layout.Begin(chunk), first + layout.End(chunk));
+    });
+}
+
+template <typename Type, typename Function>
+void ParallelForEach(Type* first, Type* last, Function f, const ParallelOptions& options = {}) {
+    ParallelChunks(first, last, options, [&f](size_t, Type* chunk_first, Type* chunk_last) {
+        std::for_each(chunk_first, chunk_last, std::ref(f));
+    });
+}
+
+// Куски выравниваются по dest: именно запись в общую кеш-линию вызывает false sharing
+template <typename InType, typename OutType, typename UnaryOp>
+OutType* ParallelTransform(const InType* first, const InType* last, OutType* dest, UnaryOp op,
+                           const ParallelOptions& options = {}) {
+    OutType* dest_last = dest + (last - first);
+    ParallelChunks(dest, dest_last, options, [&](size_t, OutType* chunk_first, OutType* chunk_last) {
+        const InType* source = first + (chunk_first - dest);
+        std::transform(source, source + (chunk_last - chunk_first), chunk_first, std::ref(op));
+    });
+    return dest_last;
+}
+
+// Каждый кусок заполняется потоковыми записями; value не должно ссылаться на элемент диапазона
+template <typename Type>
+void ParallelFill(Type* first, Type* last, const Type& value, const ParallelOptions& options = {}) {
+    if (static_cast<size_t>(last - first) * sizeof(Type) < kParallelStreamingThreshold) {
+        FillRange(first, last, value);
+        return;
+    }
+    ParallelChunks(first, last, options, [&value](size_t, Type* chunk_first, Type* chunk_last) {
+        StreamingFill(chunk_first, static_cast<size_t>(chunk_last - chunk_first), value);
+    });
+}
+
+// Как std::copy: в dest уже живут last - first элементов (тривиально копируемым
+// достаточно памяти). Диапазоны не перекрываются; куски выравниваются по dest.
+template <typename Type>
+Type* ParallelCopy(const Type* first, const Type* last, Type* dest, const ParallelOptions& options = {}) {
+    if constexpr (!kIsStreamingCopyable<Type>) {
+        return ParallelTransform(first, last, dest, [](const Type& item) -> const Type& {
+            return item;
+        }, options);
+    } else {
+        if (static_cast<size_t>(last - first) * sizeof(Type) < kParallelStreamingThreshold) {
+            return CopyRange(first, last, dest);
+        }
+        Type* dest_last = dest + (last - first);
+        ParallelChunks(dest, dest_last, options, [&](size_t, Type* chunk_first, Type* chunk_last) {
+            StreamingCopy(first + (chunk_first - dest), static_cast<size_t>(chunk_last - chunk_first), chunk_first);
+        });
+        return dest_last;
+    }
+}
+
+// Как std::reduce: op должна быть ассоциативной; порядок операндов сохраняется,
+// поэтому коммутативность не требуется, а результат не зависит от числа потоков
+template <typename Type, typename T, typename BinaryOp = std::plus<>>
+T ParallelReduce(const Type* first, const Type* last, T init, BinaryOp op = {}, const ParallelOptions& options = {}) {
+    // частичные суммы в отдельных кеш-линиях, чтобы потоки не мешали друг другу
+    struct alignas(kParallelCacheLine) Partial {
+        std::optional<T> value;
+    };
+
+    WorkStealingPool& pool = PoolFor(options);
+    const ChunkLayout layout = MakeChunkLayout(first, static_cast<size_t>(last - first), options, pool.GetThreadCount());
+    SimpleVector<Partial> partials(layout.count);
+    pool.Run(layout.count, [&](size_t chunk) {
+        const Type* it = first + layout.Begin(chunk);
+        const Type* chunk_last = first + layout.End(chunk);
+        T partial(*it);
+        for (++it; it != chunk_last; ++it) {
+            partial = op(std::move(partial), *it);
+        }
+        partials[chunk].value.emplace(std::move(partial));
+    });
+    for (Partial& partial : partials) {
+        init = op(std::move(init), std::move(*partial.value));
+    }
+    return init;
+}
+
+// Куски сортируются параллельно, затем попарно сливаются за log(count) раундов
+template <typename Type, typename Compare = std::less<>>
+void ParallelSort(Type* first, Type* last, Compare comp = {}, const ParallelOptions& options = {}) {
+    WorkStealingPool& pool = PoolFor(options);
+    const ChunkLayout layout = MakeChunkLayout(first, static_cast<size_t>(last - first), options, pool.GetThreadCount());
+    pool.Run(layout.count, [&](size_t chunk) {
+        std::sort(first + layout.Begin(chunk), first + layout.End(chunk), std::ref(comp));
+    });
+    for (size_t width = 1; width < layout.count; width *= 2) {
+        pool.Run((layout.count + 2 * width - 1) / (2 * width), [&](size_t pair) {
+            const size_t low = 2 * pair * width;
+            const size_t middle = std::min(low + width, layout.count);
+            const size_t high = std::min(low + 2 * width, layout.count);
+            if (middle < high) {
+                std::inplace_merge(first + layout.Begin(low), first + layout.Begin(middle),
+                                   first + layout.End(high - 1), std::ref(comp));
+            }
+        });
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Function>
+void ParallelForEach(SimpleVector<Type, Allocator, GrowthPolicy>& vector, Function f,
+                     const ParallelOptions& options = {}) {
+    ParallelForEach(vector.begin(), vector.end(), std::move(f), options);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Function>
+void ParallelForEach(const SimpleVector<Type, Allocator, GrowthPolicy>& vector, Function f,
+                     const ParallelOptions& options = {}) {
+    ParallelForEach(vector.begin(), vector.end(), std::move(f), options);
+}
+
+// dest должен содержать не меньше элементов, чем source
+template <typename InType, typename InAllocator, typename InGrowth, typename OutType, typename OutAllocator,
+          typename OutGrowth, typename UnaryOp>
+void ParallelTransform(const SimpleVector<InType, InAllocator, InGrowth>& source,
+                       SimpleVector<OutType, OutAllocator, OutGrowth>& dest, UnaryOp op,
+                       const ParallelOptions& options = {}) {
+    assert(dest.GetSize() >= source.GetSize());
+    ParallelTransform(source.begin(), source.end(), dest.begin(), std::move(op), options);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename T, typename BinaryOp = std::plus<>>
+T ParallelReduce(const SimpleVector<Type, Allocator, GrowthPolicy>& vector, T init, BinaryOp op = {},
+                 const ParallelOptions& options = {}) {
+    return ParallelReduce(vector.begin(), vector.end(), std::move(init), std::move(op), options);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Compare = std::less<>>
+void ParallelSort(SimpleVector<Type, Allocator, GrowthPolicy>& vector, Compare comp = {},
+                  const ParallelOptions& options = {}) {
+    ParallelSort(vector.begin(), vector.end(), std::move(comp), options);
+}
+
+// Заменяет содержимое vector count копиями value. Тривиальные элементы
+// заполняются параллельно, остальные — через vector.Assign
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void ParallelAssign(SimpleVector<Type, Allocator, GrowthPolicy>& vector, size_t count, const Type& value,
+                    const ParallelOptions& options = {}) {
+    if constexpr (kIsStreamingAssignable<Type>) {
+        // value может ссылаться на элемент вектора
+        const Type copy(value);
+        vector.Clear();
+        vector.Reserve(count);
+        vector.Resize(count, default_init);
+        ParallelFill(vector.begin(), vector.end(), copy, options);
+    } else {
+        vector.Assign(count, value);
+    }
+}
+
+// Копирует source в dest, деля копирование тривиальных элементов между потоками
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void ParallelAssign(SimpleVector<Type, Allocator, GrowthPolicy>& dest,
+                    const SimpleVector<Type, Allocator, GrowthPolicy>& source, const ParallelOptions& options = {}) {
+    if (&dest == &source) {
+        return;
+    }
+    if constexpr (kIsStreamingAssignable<Type>) {
+        dest.Clear();
+        dest.Reserve(source.GetSize());
+        dest.Resize(source.GetSize(), default_init);
+        ParallelCopy(source.begin(), source.end(), dest.begin(), options);
+    } else {
+        dest = source;
+    }
+}
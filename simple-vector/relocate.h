@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "allocator_utils.h"
+
+// Тип можно переносить побайтовым копированием, не вызывая конструктор
+// перемещения и деструктор исходного объекта. Для типов-дескрипторов
+// (например, владеющих указателей) можно специализировать явно:
+//     template <> struct is_trivially_relocatable<Handle> : std::true_type {};
+template <typename Type>
+struct is_trivially_relocatable : std::is_trivially_copyable<Type> {};
+
+template <typename Type>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Type>::value;
+
+// Переносит [first, last) в неинициализированную память dest (диапазоны не пересекаются).
+// Исходные объекты разрушаются. Если перенос бросает исключение,
+// исходный диапазон остаётся нетронутым (кроме некопируемых типов с бросающим перемещением).
+// Тривиально переносимые объекты копируются побайтово в обход construct/destroy аллокатора.
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void UninitializedRelocate(Allocator& alloc, Type* first, Type* last, Type* dest) {
+    if constexpr (is_trivially_relocatable_v<Type>) {
+        if (!IsConstantEvaluated()) {
+            if (first != last) {
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                            (last - first) * sizeof(Type));
+            }
+            return;
+        }
+    }
+    UninitializedMoveIfNoexcept(alloc, first, last, dest);
+    DestroyRange(alloc, first, last);
+}
+
+// Побайтово сдвигает [first, last) в dest, диапазоны могут пересекаться.
+// Только для тривиально переносимых типов.
+template <typename Type>
+void RelocateOverlapping(Type* first, Type* last, Type* dest) noexcept {
+    static_assert(is_trivially_relocatable_v<Type>);
+    if (first != last) {
+        std::memmove(static_cast<void*>(dest), static_cast<const void*>(first),
+                     (last - first) * sizeof(Type));
+    }
+}
+
+// Сдвиг элементов на одну позицию не бросает исключений
+template <typename Type>
+inline constexpr bool kIsNothrowShiftable =
+    is_trivially_relocatable_v<Type>
+    || (std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>);
+
+// Переносит [first, last) в dest, оставляя gap свободных позиций начиная с dest[index].
+// Исходные объекты разрушаются только после успешного переноса (строгая гарантия).
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void RelocateAroundGap(Allocator& alloc, Type* first, Type* last, size_t index, size_t gap, Type* dest) {
+    if constexpr (is_trivially_relocatable_v<Type>) {
+        UninitializedRelocate(alloc, first, first + index, dest);
+        UninitializedRelocate(alloc, first + index, last, dest + index + gap);
+    } else {
+        UninitializedMoveIfNoexcept(alloc, first, first + index, dest);
+        try {
+            UninitializedMoveIfNoexcept(alloc, first + index, last, dest + index + gap);
+        } catch (...) {
+            DestroyRange(alloc, dest, dest + index);
+            throw;
+        }
+        DestroyRange(alloc, first, last);
+    }
+}
+
+// Конструирует элемент в dest[index] и переносит вокруг него [first, last)
+template <typename Allocator, typename Type, typename... Args>
+SIMPLE_VECTOR_CONSTEXPR void RelocateAndEmplace(Allocator& alloc, Type* first, Type* last, size_t index, Type* dest, Args&&... args) {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    Type* new_pos = dest + index;
+    AllocTraits::construct(alloc, new_pos, std::forward<Args>(args)...);
+    try {
+        RelocateAroundGap(alloc, first, last, index, 1, dest);
+    } catch (...) {
+        AllocTraits::destroy(alloc, new_pos);
+        throw;
+    }
+}
+
+// Копирует count элементов из src в dest[index] и переносит вокруг них [first, last)
+template <typename Allocator, typename Type, typename ForwardIt>
+SIMPLE_VECTOR_CONSTEXPR void RelocateAndInsert(Allocator& alloc, Type* first, Type* last, size_t index, Type* dest,
+                       ForwardIt src, size_t count) {
+    Type* gap_first = dest + index;
+    UninitializedCopy(alloc, src, std::next(src, count), gap_first);
+    try {
+        RelocateAroundGap(alloc, first, last, index, count, dest);
+    } catch (...) {
+        DestroyRange(alloc, gap_first, gap_first + count);
+        throw;
+    }
+}
+
+// Вставляет элемент перед pos, сдвигая [pos, last) на одну позицию вправо.
+// За last должна быть свободная память под один элемент.
+template <typename Allocator, typename Type, typename... Args>
+SIMPLE_VECTOR_CONSTEXPR void EmplaceShifting(Allocator& alloc, Type* pos, Type* last, Args&&... args) {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    if (pos == last) {
+        AllocTraits::construct(alloc, last, std::forward<Args>(args)...);
+        return;
+    }
+    if constexpr (is_trivially_relocatable_v<Type>) {
+        if (!IsConstantEvaluated()) {
+            // объект создаётся до сдвига: аргументы могут ссылаться на сдвигаемые элементы
+            alignas(Type) unsigned char buffer[sizeof(Type)];
+            Type* value = reinterpret_cast<Type*>(buffer);
+            AllocTraits::construct(alloc, value, std::forward<Args>(args)...);
+            RelocateOverlapping(pos, last, pos + 1);
+            UninitializedRelocate(alloc, value, value + 1, pos);
+            return;
+        }
+    }
+    Type value(std::forward<Args>(args)...);
+    AllocTraits::construct(alloc, last, std::move(*(last - 1)));
+    std::move_backward(pos, last - 1, last);
+    *pos = std::move(value);
+}
+
+// Удаляет [first, last), сдвигая [last, end) влево на место удалённых.
+// После вызова память [end - (last - first), end) не инициализирована.
+template <typename Allocator, typename Type>
+SIMPLE_VECTOR_CONSTEXPR void EraseShifting(Allocator& alloc, Type* first, Type* last, Type* end) {
+    if (first == last) {
+        return;
+    }
+    if constexpr (is_trivially_relocatable_v<Type>) {
+        if (!IsConstantEvaluated()) {
+            DestroyRange(alloc, first, last);
+            RelocateOverlapping(last, end, first);
+            return;
+        }
+    }
+    Type* new_end = std::move(last, end, first);
+    DestroyRange(alloc, new_end, end);
+}
+
+// Вставляет count элементов из src перед data[index], сдвигая хвост один раз.
+// За data[size] должна быть свободная память под count элементов; size увеличивается
+// на число элементов, которые остаются живыми, в том числе при исключении.
+// src не должен указывать на элементы самого буфера.
+template <typename Allocator, typename Type, typename ForwardIt>
+SIMPLE_VECTOR_CONSTEXPR void InsertShifting(Allocator& alloc, Type* data, size_t& size, size_t index,
+                                            ForwardIt src, size_t count) {
+    Type* pos = data + index;
+    Type* last = data + size;
+    if constexpr (is_trivially_relocatable_v<Type>) {
+        if (!IsConstantEvaluated()) {
+            RelocateOverlapping(pos, last, pos + count);
+            try {
+                UninitializedCopy(alloc, src, std::next(src, count), pos);
+            } catch (...) {
+                RelocateOverlapping(pos + count, last + count, pos);
+                throw;
+            }
+            size += count;
+            return;
+        }
+    }
+    const size_t elems_after = size - index;
+    if (elems_after > count) {
+        UninitializedMove(alloc, last - count, last, last);
+        size += count;
+        std::move_backward(pos, last - count, last);
+        std::copy_n(src, count, pos);
+    } else {
+        ForwardIt mid = std::next(src, elems_after);
+        UninitializedCopy(alloc, mid, std::next(mid, count - elems_after), last);
+        try {
+            UninitializedMove(alloc, pos, last, pos + count);
+        } catch (...) {
+            DestroyRange(alloc, last, pos + count);
+            throw;
+        }
+        size += count;
+        std::copy(src, mid, pos);
+    }
+}
+
+// Прямой итератор, count раз возвращающий одно и то же значение
+template <typename Type>
+class RepeatIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Type*;
+    using reference = const Type&;
+
+    constexpr RepeatIterator() = default;
+    constexpr RepeatIterator(const Type& value, size_t index) noexcept
+        : value_(&value),
+          index_(index) {
+    }
+
+    constexpr reference operator*() const noexcept {
+        return *value_;
+    }
+    constexpr pointer operator->() const noexcept {
+        return value_;
+    }
+    constexpr RepeatIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+    constexpr RepeatIterator operator++(int) noexcept {
+        RepeatIterator old = *this;
+        ++index_;
+        return old;
+    }
+    constexpr bool operator==(const RepeatIterator& other) const noexcept {
+        return index_ == other.index_;
+    }
+    constexpr bool operator!=(const RepeatIterator& other) const noexcept {
+        return index_ != other.index_;
+    }
+
+private:
+    const Type* value_ = nullptr;
+    size_t index_ = 0;
+};
+
+template <typename Iterator>
+inline constexpr bool kIsForwardIterator = std::is_base_of_v<
+    std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>;
+
+template <typename Iterator>
+using RequireInputIterator = std::enable_if_t<std::is_base_of_v<
+    std::input_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>>;
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+#include "bounds_check.h"
+#include "simple_vector.h"
+
+// Размер сегмента по умолчанию: наибольшая степень двойки элементов,
+// умещающаяся в 16 КиБ, но не меньше 8 элементов
+template <typename Type>
+constexpr size_t DefaultSegmentSize() noexcept {
+    size_t size = 8;
+    while (size * 2 * sizeof(Type) <= 16 * 1024) {
+        size *= 2;
+    }
+    return size;
+}
+
+// Вектор из таблицы сегментов фиксированного размера. При росте добавляется
+// новый сегмент, а существующие элементы не перемещаются: ссылки на них
+// остаются действительными, и пиковая память близка к размеру, а не к
+// удвоенной ёмкости. Индекс раскладывается на номер сегмента и смещение
+// сдвигом и маской.
+template <typename Type, size_t SegmentSize = DefaultSegmentSize<Type>()>
+class SegmentedSimpleVector {
+    static_assert(SegmentSize != 0 && (SegmentSize & (SegmentSize - 1)) == 0,
+                  "SegmentSize must be a power of two");
+
+    static constexpr size_t kShift = [] {
+        size_t shift = 0;
+        while ((size_t{1} << shift) != SegmentSize) {
+            ++shift;
+        }
+        return shift;
+    }();
+    static constexpr size_t kMask = SegmentSize - 1;
+
+    template <bool IsConst>
+    class BasicIterator {
+        using Owner = std::conditional_t<IsConst, const SegmentedSimpleVector, SegmentedSimpleVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner),
+              index_(index) {
+        }
+
+        operator BasicIterator<true>() const noexcept {
+            return BasicIterator<true>(owner_, index_);
+        }
+
+        reference operator*() const noexcept {
+            return *owner_->SlotAt(index_);
+        }
+
+        pointer operator->() const noexcept {
+            return owner_->SlotAt(index_);
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    static constexpr size_t kSegmentSize = SegmentSize;
+
+    SegmentedSimpleVector() noexcept = default;
+
+    explicit SegmentedSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    SegmentedSimpleVector(size_t size, const Type& value) {
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(value);
+        }
+    }
+
+    SegmentedSimpleVector(std::initializer_list<Type> init) {
+        Reserve(init.size());
+        for (const Type& item : init) {
+            PushBack(item);
+        }
+    }
+
+    SegmentedSimpleVector(const SegmentedSimpleVector& other) {
+        Reserve(other.size_);
+        other.ForEachSegment([this](const Type* first, const Type* last) {
+            for (; first != last; ++first) {
+                PushBack(*first);
+            }
+        });
+    }
+
+    SegmentedSimpleVector(SegmentedSimpleVector&& other) noexcept
+        : size_(std::exchange(other.size_, 0)),
+          segments_(std::move(other.segments_)) {
+    }
+
+    SegmentedSimpleVector& operator=(const SegmentedSimpleVector& rhs) {
+        if (this != &rhs) {
+            SegmentedSimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SegmentedSimpleVector& operator=(SegmentedSimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            segments_ = std::move(rhs.segments_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    ~SegmentedSimpleVector() {
+        Clear();
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return segments_.GetSize() * SegmentSize;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return *SlotAt(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return *SlotAt(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *SlotAt(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *SlotAt(index);
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Элементы не перемещаются, поэтому args могут ссылаться на элементы вектора
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            segments_.EmplaceBack(SegmentSize);
+        }
+        Type* slot = SlotAt(size_);
+        new (slot) Type(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PopBack() noexcept {
+        HardenedCheck(size_ > 0, "PopBack on a non-empty container");
+        --size_;
+        std::destroy_at(SlotAt(size_));
+    }
+
+    // Сегменты сохраняются для повторного использования
+    void Clear() noexcept {
+        ForEachSegment([](Type* first, Type* last) {
+            std::destroy(first, last);
+        });
+        size_ = 0;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            const size_t segments = (new_capacity + kMask) >> kShift;
+            segments_.Reserve(segments);
+            while (segments_.GetSize() < segments) {
+                segments_.EmplaceBack(SegmentSize);
+            }
+        }
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            while (size_ > new_size) {
+                PopBack();
+            }
+        } else {
+            Reserve(new_size);
+            while (size_ < new_size) {
+                EmplaceBack();
+            }
+        }
+    }
+
+    // Освобождает сегменты за последним занятым
+    void ShrinkToFit() {
+        const size_t used = (size_ + kMask) >> kShift;
+        while (segments_.GetSize() > used) {
+            segments_.PopBack();
+        }
+        segments_.ShrinkToFit();
+    }
+
+    void swap(SegmentedSimpleVector& other) noexcept {
+        std::swap(size_, other.size_);
+        segments_.swap(other.segments_);
+    }
+
+    // Вызывает function(first, last) для непрерывных кусков по порядку:
+    // внутри сегмента циклы векторизуются, в отличие от обхода итераторами
+    template <typename Function>
+    void ForEachSegment(Function function) {
+        for (size_t start = 0; start < size_; start += SegmentSize) {
+            Type* first = segments_[start >> kShift].Get();
+            function(first, first + std::min(SegmentSize, size_ - start));
+        }
+    }
+
+    template <typename Function>
+    void ForEachSegment(Function function) const {
+        for (size_t start = 0; start < size_; start += SegmentSize) {
+            const Type* first = segments_[start >> kShift].Get();
+            function(first, first + std::min(SegmentSize, size_ - start));
+        }
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    Type* SlotAt(size_t index) const noexcept {
+        return segments_[index >> kShift].Get() + (index & kMask);
+    }
+
+    size_t size_ = 0;
+    SimpleVector<ArrayPtr<Type>> segments_;
+};
+
+template <typename Type, size_t SegmentSize>
+inline bool operator==(const SegmentedSimpleVector<Type, SegmentSize>& lhs,
+                       const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) return false;
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <typename Type, size_t SegmentSize>
+inline bool operator!=(const SegmentedSimpleVector<Type, SegmentSize>& lhs,
+                       const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t SegmentSize>
+inline bool operator<(const SegmentedSimpleVector<Type, SegmentSize>& lhs,
+                      const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, size_t SegmentSize>
+inline bool operator<=(const SegmentedSimpleVector<Type, SegmentSize>& lhs,
+                       const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t SegmentSize>
+inline bool operator>(const SegmentedSimpleVector<Type, SegmentSize>& lhs,
+                      const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t SegmentSize>
+inline bool operator>=(const SegmentedSimpleVector<Type, SegmentSize>& lhs,
+                       const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include "simple_vector.h"
+
+// Двоичная сериализация SimpleVector тривиально копируемых элементов:
+// заголовок фиксированного размера и затем содержимое буфера одним блоком.
+// Порядок байт и представление элементов не преобразуются, поэтому файл
+// читается только на платформе с тем же порядком байт и размером элемента.
+
+struct SerializationHeader {
+    static constexpr uint32_t kMagic = 0x43455653;  // "SVEC" в little-endian
+    static constexpr uint16_t kVersion = 1;
+    static constexpr uint16_t kByteOrderMark = 0x0102;
+
+    uint32_t magic = kMagic;
+    uint16_t version = kVersion;
+    uint16_t byte_order = kByteOrderMark;
+    uint32_t element_size = 0;
+    uint32_t element_alignment = 0;
+    uint64_t size = 0;
+};
+
+static_assert(sizeof(SerializationHeader) == 24, "header layout must not depend on padding");
+
+class SerializationError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+template <typename Type>
+SerializationHeader MakeSerializationHeader(size_t size) noexcept {
+    SerializationHeader header;
+    header.element_size = sizeof(Type);
+    header.element_alignment = alignof(Type);
+    header.size = size;
+    return header;
+}
+
+// Проверяет заголовок и возвращает число элементов
+template <typename Type>
+size_t CheckSerializationHeader(const SerializationHeader& header) {
+    if (header.magic != SerializationHeader::kMagic) {
+        throw SerializationError("not a serialized SimpleVector");
+    }
+    if (header.version != SerializationHeader::kVersion) {
+        throw SerializationError("unsupported serialization version");
+    }
+    if (header.byte_order != SerializationHeader::kByteOrderMark) {
+        throw SerializationError("byte order mismatch");
+    }
+    if (header.element_size != sizeof(Type) || header.element_alignment != alignof(Type)) {
+        throw SerializationError("element type mismatch");
+    }
+    if (header.size > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+        throw SerializationError("serialized size is too large");
+    }
+    return static_cast<size_t>(header.size);
+}
+
+// write(2) может записать меньше запрошенного: дописывает остаток
+inline void WriteAll(int fd, const void* data, size_t bytes) {
+    const char* current = static_cast<const char*>(data);
+    while (bytes != 0) {
+        const ssize_t written = ::write(fd, current, bytes);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+        current += written;
+        bytes -= static_cast<size_t>(written);
+    }
+}
+
+inline void ReadAll(int fd, void* data, size_t bytes) {
+    char* current = static_cast<char*>(data);
+    while (bytes != 0) {
+        const ssize_t read = ::read(fd, current, bytes);
+        if (read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (read == 0) {
+            throw SerializationError("unexpected end of serialized data");
+        }
+        current += read;
+        bytes -= static_cast<size_t>(read);
+    }
+}
+
+// Размер заголовка не подтверждён данными: источник без известной длины читается
+// кусками, и память растёт только вместе с прочитанными байтами
+inline constexpr size_t kSerializationChunkBytes = size_t{1} << 20;
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename ReadBlock>
+void ReadInChunks(SimpleVector<Type, Allocator, GrowthPolicy>& vector, size_t size, ReadBlock read_block) {
+    const size_t chunk = std::max<size_t>(1, kSerializationChunkBytes / sizeof(Type));
+    while (vector.GetSize() < size) {
+        const size_t offset = vector.GetSize();
+        const size_t count = std::min(chunk, size - offset);
+        // ёмкость удваивается, чтобы куски не копировали буфер каждый раз
+        if (offset + count > vector.GetCapacity()) {
+            vector.Reserve(std::min(size, std::max(offset + count, 2 * vector.GetCapacity())));
+        }
+        vector.Resize(offset + count, default_init);
+        read_block(vector.begin() + offset, count * sizeof(Type));
+    }
+}
+
+// Байты от текущей позиции до конца обычного файла; для каналов и сокетов
+// длина неизвестна
+inline bool RemainingFileBytes(int fd, uint64_t& bytes) noexcept {
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+    }
+    const off_t position = ::lseek(fd, 0, SEEK_CUR);
+    if (position < 0 || position > info.st_size) {
+        return false;
+    }
+    bytes = static_cast<uint64_t>(info.st_size - position);
+    return true;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void WriteTo(std::ostream& out, const SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be serialized");
+    const SerializationHeader header = MakeSerializationHeader<Type>(vector.GetSize());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(vector.begin()),
+              static_cast<std::streamsize>(vector.GetSize() * sizeof(Type)));
+    if (!out) {
+        throw SerializationError("failed to write serialized data");
+    }
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void WriteTo(int fd, const SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be serialized");
+    const SerializationHeader header = MakeSerializationHeader<Type>(vector.GetSize());
+    WriteAll(fd, &header, sizeof(header));
+    WriteAll(fd, vector.begin(), vector.GetSize() * sizeof(Type));
+}
+
+// Заменяет содержимое vector прочитанным: поток читается кусками по
+// kSerializationChunkBytes, так что обрезанный или подделанный заголовок не
+// выделяет памяти больше, чем в потоке данных. При ошибке vector остаётся пустым.
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void ReadFrom(std::istream& in, SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be serialized");
+    vector.Clear();
+    SerializationHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw SerializationError("unexpected end of serialized data");
+    }
+    const size_t size = CheckSerializationHeader<Type>(header);
+    try {
+        ReadInChunks(vector, size, [&in](Type* data, size_t bytes) {
+            if (!in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(bytes))) {
+                throw SerializationError("unexpected end of serialized data");
+            }
+        });
+    } catch (...) {
+        vector.Clear();
+        throw;
+    }
+}
+
+// Из обычного файла — одно выделение памяти и одно чтение блока, если файл
+// действительно содержит заявленные байты; из канала — кусками, как из потока
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void ReadFrom(int fd, SimpleVector<Type, Allocator, GrowthPolicy>& vector) {
+    static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be serialized");
+    vector.Clear();
+    SerializationHeader header;
+    ReadAll(fd, &header, sizeof(header));
+    const size_t size = CheckSerializationHeader<Type>(header);
+    try {
+        if (uint64_t remaining = 0; RemainingFileBytes(fd, remaining)) {
+            if (size * sizeof(Type) > remaining) {
+                throw SerializationError("unexpected end of serialized data");
+            }
+            vector.Resize(size, default_init);
+            ReadAll(fd, vector.begin(), size * sizeof(Type));
+        } else {
+            ReadInChunks(vector, size, [fd](Type* data, size_t bytes) {
+                ReadAll(fd, data, bytes);
+            });
+        }
+    } catch (...) {
+        vector.Clear();
+        throw;
+    }
+}
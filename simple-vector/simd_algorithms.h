@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "constexpr_support.h"
+
+// Сравнение и поиск по непрерывным диапазонам. Для арифметических типов
+// используются memcmp и векторные ядра AVX2 (выбираются во время выполнения,
+// если процессор их поддерживает), для остальных — стандартные алгоритмы.
+// Семантика совпадает с std::equal, std::lexicographical_compare,
+// std::find и std::count, в том числе для NaN и -0.0.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMPLE_VECTOR_AVX2_DISPATCH 1
+#include <immintrin.h>
+#define SIMPLE_VECTOR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+template <typename Type>
+inline constexpr bool kHasSimdKernels =
+    std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>
+    && (sizeof(Type) == 1 || sizeof(Type) == 2 || sizeof(Type) == 4 || sizeof(Type) == 8);
+
+template <typename Type>
+size_t ScalarMismatch(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    size_t i = 0;
+    while (i < size && lhs[i] == rhs[i]) {
+        ++i;
+    }
+    return i;
+}
+
+template <typename Type>
+size_t ScalarFind(const Type* data, size_t size, Type value) noexcept {
+    size_t i = 0;
+    while (i < size && !(data[i] == value)) {
+        ++i;
+    }
+    return i;
+}
+
+template <typename Type>
+size_t ScalarCount(const Type* data, size_t size, Type value) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+#ifdef SIMPLE_VECTOR_AVX2_DISPATCH
+
+inline bool CpuHasAvx2() noexcept {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2 inline __m256i Avx2Load(const Type* data) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2 inline __m256i Avx2Broadcast(Type value) noexcept {
+    if constexpr (std::is_same_v<Type, float>) {
+        return _mm256_castps_si256(_mm256_set1_ps(value));
+    } else if constexpr (std::is_same_v<Type, double>) {
+        return _mm256_castpd_si256(_mm256_set1_pd(value));
+    } else if constexpr (sizeof(Type) == 1) {
+        return _mm256_set1_epi8(static_cast<char>(value));
+    } else if constexpr (sizeof(Type) == 2) {
+        return _mm256_set1_epi16(static_cast<short>(value));
+    } else if constexpr (sizeof(Type) == 4) {
+        return _mm256_set1_epi32(static_cast<int>(value));
+    } else {
+        return _mm256_set1_epi64x(static_cast<long long>(value));
+    }
+}
+
+// Побайтовая маска равных элементов: каждый элемент даёт sizeof(Type) бит
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2 inline unsigned Avx2EqualMask(__m256i lhs, __m256i rhs) noexcept {
+    __m256i equal;
+    if constexpr (std::is_same_v<Type, float>) {
+        equal = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs), _CMP_EQ_OQ));
+    } else if constexpr (std::is_same_v<Type, double>) {
+        equal = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs), _CMP_EQ_OQ));
+    } else if constexpr (sizeof(Type) == 1) {
+        equal = _mm256_cmpeq_epi8(lhs, rhs);
+    } else if constexpr (sizeof(Type) == 2) {
+        equal = _mm256_cmpeq_epi16(lhs, rhs);
+    } else if constexpr (sizeof(Type) == 4) {
+        equal = _mm256_cmpeq_epi32(lhs, rhs);
+    } else {
+        equal = _mm256_cmpeq_epi64(lhs, rhs);
+    }
+    return static_cast<unsigned>(_mm256_movemask_epi8(equal));
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2 size_t Avx2Mismatch(const Type* lhs, const Type* rhs, size_t size) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(Type);
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+        const unsigned mask = Avx2EqualMask<Type>(Avx2Load(lhs + i), Avx2Load(rhs + i));
+        if (mask != 0xFFFFFFFFu) {
+            return i + __builtin_ctz(~mask) / sizeof(Type);
+        }
+    }
+    return i + ScalarMismatch(lhs + i, rhs + i, size - i);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2 size_t Avx2Find(const Type* data, size_t size, Type value) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(Type);
+    const __m256i needle = Avx2Broadcast(value);
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+        const unsigned mask = Avx2EqualMask<Type>(Avx2Load(data + i), needle);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask) / sizeof(Type);
+        }
+    }
+    return i + ScalarFind(data + i, size - i, value);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_TARGET_AVX2 size_t Avx2Count(const Type* data, size_t size, Type value) noexcept {
+    constexpr size_t kLanes = 32 / sizeof(Type);
+    const __m256i needle = Avx2Broadcast(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes) {
+        count += __builtin_popcount(Avx2EqualMask<Type>(Avx2Load(data + i), needle)) / sizeof(Type);
+    }
+    return count + ScalarCount(data + i, size - i, value);
+}
+
+#endif
+
+// Индекс первого различающегося (по ==) элемента или size
+template <typename Type>
+size_t SimdMismatch(const Type* lhs, const Type* rhs, size_t size) noexcept {
+#ifdef SIMPLE_VECTOR_AVX2_DISPATCH
+    if (size >= 32 / sizeof(Type) && CpuHasAvx2()) {
+        return Avx2Mismatch(lhs, rhs, size);
+    }
+#endif
+    return ScalarMismatch(lhs, rhs, size);
+}
+
+template <typename Type>
+size_t SimdFind(const Type* data, size_t size, Type value) noexcept {
+#ifdef SIMPLE_VECTOR_AVX2_DISPATCH
+    if (size >= 32 / sizeof(Type) && CpuHasAvx2()) {
+        return Avx2Find(data, size, value);
+    }
+#endif
+    return ScalarFind(data, size, value);
+}
+
+template <typename Type>
+size_t SimdCount(const Type* data, size_t size, Type value) noexcept {
+#ifdef SIMPLE_VECTOR_AVX2_DISPATCH
+    if (size >= 32 / sizeof(Type) && CpuHasAvx2()) {
+        return Avx2Count(data, size, value);
+    }
+#endif
+    return ScalarCount(data, size, value);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR bool RangeEqual(const Type* lhs, const Type* rhs, size_t size) {
+    if (IsConstantEvaluated()) {
+        return std::equal(lhs, lhs + size, rhs);
+    }
+    if constexpr (kHasSimdKernels<Type> && std::is_integral_v<Type>) {
+        return size == 0 || std::memcmp(lhs, rhs, size * sizeof(Type)) == 0;
+    } else if constexpr (kHasSimdKernels<Type>) {
+        return SimdMismatch(lhs, rhs, size) == size;
+    } else {
+        return std::equal(lhs, lhs + size, rhs);
+    }
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR bool RangeLess(const Type* lhs, size_t lhs_size, const Type* rhs, size_t rhs_size) {
+    if (IsConstantEvaluated()) {
+        return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);
+    }
+    const size_t common = std::min(lhs_size, rhs_size);
+    if constexpr (kHasSimdKernels<Type> && std::is_unsigned_v<Type> && sizeof(Type) == 1) {
+        const int order = common == 0 ? 0 : std::memcmp(lhs, rhs, common);
+        return order < 0 || (order == 0 && lhs_size < rhs_size);
+    } else if constexpr (kHasSimdKernels<Type>) {
+        size_t offset = 0;
+        while (true) {
+            const size_t i = offset + SimdMismatch(lhs + offset, rhs + offset, common - offset);
+            if (i == common) {
+                return lhs_size < rhs_size;
+            }
+            if (lhs[i] < rhs[i]) {
+                return true;
+            }
+            if (rhs[i] < lhs[i]) {
+                return false;
+            }
+            // несравнимые значения (NaN) эквивалентны, как в std::lexicographical_compare
+            offset = i + 1;
+        }
+    } else {
+        return std::lexicographical_compare(lhs, lhs + lhs_size, rhs, rhs + rhs_size);
+    }
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR const Type* RangeFind(const Type* first, const Type* last, const Type& value) {
+    if (IsConstantEvaluated()) {
+        return std::find(first, last, value);
+    }
+    if constexpr (kHasSimdKernels<Type>) {
+        return first + SimdFind(first, static_cast<size_t>(last - first), value);
+    } else {
+        return std::find(first, last, value);
+    }
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR size_t RangeCount(const Type* first, const Type* last, const Type& value) {
+    if (IsConstantEvaluated()) {
+        return static_cast<size_t>(std::count(first, last, value));
+    }
+    if constexpr (kHasSimdKernels<Type>) {
+        return SimdCount(first, static_cast<size_t>(last - first), value);
+    } else {
+        return static_cast<size_t>(std::count(first, last, value));
+    }
+}
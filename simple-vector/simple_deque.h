@@ -0,0 +1,443 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+#include "bounds_check.h"
+#include "relocate.h"
+#include "simple_vector_view.h"
+
+// Двусторонняя очередь на кольцевом буфере ArrayPtr: вставка и удаление
+// с обоих концов за O(1) без сдвига элементов. Ёмкость всегда степень двойки,
+// поэтому позиция в буфере вычисляется маской. Содержимое занимает не больше
+// двух непрерывных кусков (FirstSpan, SecondSpan), которые удобно отдавать
+// в пакетный ввод-вывод. При перевыделении элементы укладываются подряд с начала буфера.
+template <typename Type>
+class SimpleDeque {
+    template <bool IsConst>
+    class BasicIterator {
+        using Owner = std::conditional_t<IsConst, const SimpleDeque, SimpleDeque>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner),
+              index_(index) {
+        }
+
+        operator BasicIterator<true>() const noexcept {
+            return BasicIterator<true>(owner_, index_);
+        }
+
+        reference operator*() const noexcept {
+            return *owner_->SlotAt(index_);
+        }
+
+        pointer operator->() const noexcept {
+            return owner_->SlotAt(index_);
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    SimpleDeque() noexcept = default;
+
+    SimpleDeque(std::initializer_list<Type> init) {
+        Reserve(init.size());
+        for (const Type& item : init) {
+            PushBack(item);
+        }
+    }
+
+    SimpleDeque(const SimpleDeque& other) {
+        Reserve(other.size_);
+        for (const Type& item : other) {
+            PushBack(item);
+        }
+    }
+
+    SimpleDeque(SimpleDeque&& other) noexcept
+        : items_(std::move(other.items_)),
+          head_(std::exchange(other.head_, 0)),
+          size_(std::exchange(other.size_, 0)) {
+    }
+
+    SimpleDeque& operator=(const SimpleDeque& rhs) {
+        if (this != &rhs) {
+            SimpleDeque temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SimpleDeque& operator=(SimpleDeque&& rhs) noexcept {
+        if (this != &rhs) {
+            SimpleDeque temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~SimpleDeque() {
+        Clear();
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return items_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return *SlotAt(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return *SlotAt(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *SlotAt(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *SlotAt(index);
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    void PushFront(const Type& item) {
+        EmplaceFront(item);
+    }
+
+    void PushFront(Type&& item) {
+        EmplaceFront(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(false, std::forward<Args>(args)...);
+        } else {
+            new (SlotAt(size_)) Type(std::forward<Args>(args)...);
+            ++size_;
+        }
+        return *SlotAt(size_ - 1);
+    }
+
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(true, std::forward<Args>(args)...);
+        } else {
+            const size_t new_head = (head_ - 1) & Mask();
+            new (items_.Get() + new_head) Type(std::forward<Args>(args)...);
+            head_ = new_head;
+            ++size_;
+        }
+        return *SlotAt(0);
+    }
+
+    void PopBack() noexcept {
+        HardenedCheck(size_ > 0, "PopBack on a non-empty container");
+        std::destroy_at(SlotAt(size_ - 1));
+        --size_;
+        ResetHeadIfEmpty();
+    }
+
+    void PopFront() noexcept {
+        HardenedCheck(size_ > 0, "PopFront on a non-empty container");
+        std::destroy_at(SlotAt(0));
+        head_ = (head_ + 1) & Mask();
+        --size_;
+        ResetHeadIfEmpty();
+    }
+
+    void Clear() noexcept {
+        std::destroy(FirstSpan().begin(), FirstSpan().end());
+        std::destroy(SecondSpan().begin(), SecondSpan().end());
+        head_ = 0;
+        size_ = 0;
+    }
+
+    // Ёмкость округляется вверх до степени двойки
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            ArrayPtr<Type> new_items(RoundUpToPowerOfTwo(new_capacity));
+            RelocateTo(new_items.Get());
+            items_.swap(new_items);
+            head_ = 0;
+        }
+    }
+
+    // Элементы с начала очереди до конца буфера; пуст, только если пуста очередь
+    SimpleVectorView<Type> FirstSpan() noexcept {
+        return SimpleVectorView<Type>(items_.Get() + head_, FirstSpanSize());
+    }
+
+    SimpleVectorView<const Type> FirstSpan() const noexcept {
+        return SimpleVectorView<const Type>(items_.Get() + head_, FirstSpanSize());
+    }
+
+    // Продолжение очереди с начала буфера после перехода через его конец
+    SimpleVectorView<Type> SecondSpan() noexcept {
+        return SimpleVectorView<Type>(items_.Get(), size_ - FirstSpanSize());
+    }
+
+    SimpleVectorView<const Type> SecondSpan() const noexcept {
+        return SimpleVectorView<const Type>(items_.Get(), size_ - FirstSpanSize());
+    }
+
+    void swap(SimpleDeque& other) noexcept {
+        items_.swap(other.items_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    // Степени двойки больше 2^63 не помещаются в size_t
+    static size_t RoundUpToPowerOfTwo(size_t value) {
+        if (value > (std::numeric_limits<size_t>::max() >> 1) + 1) {
+            throw std::length_error("SimpleDeque capacity exceeds the largest power of two");
+        }
+        size_t result = 1;
+        while (result < value) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    size_t Mask() const noexcept {
+        return GetCapacity() - 1;
+    }
+
+    Type* SlotAt(size_t index) const noexcept {
+        return items_.Get() + ((head_ + index) & Mask());
+    }
+
+    size_t FirstSpanSize() const noexcept {
+        return std::min(size_, GetCapacity() - head_);
+    }
+
+    // Пустая очередь снова начинается с начала буфера, чтобы занимать один кусок
+    void ResetHeadIfEmpty() noexcept {
+        if (size_ == 0) {
+            head_ = 0;
+        }
+    }
+
+    // Переносит элементы подряд в dest. Исходные объекты разрушаются
+    // только после успешного переноса обоих кусков (строгая гарантия).
+    void RelocateTo(Type* dest) {
+        std::allocator<Type> alloc;
+        const SimpleVectorView<Type> first = FirstSpan();
+        const SimpleVectorView<Type> second = SecondSpan();
+        Type* second_dest = dest + first.GetSize();
+        if constexpr (is_trivially_relocatable_v<Type>) {
+            UninitializedRelocate(alloc, first.begin(), first.end(), dest);
+            UninitializedRelocate(alloc, second.begin(), second.end(), second_dest);
+        } else {
+            UninitializedMoveIfNoexcept(alloc, first.begin(), first.end(), dest);
+            try {
+                UninitializedMoveIfNoexcept(alloc, second.begin(), second.end(), second_dest);
+            } catch (...) {
+                DestroyRange(alloc, dest, second_dest);
+                throw;
+            }
+            DestroyRange(alloc, first.begin(), first.end());
+            DestroyRange(alloc, second.begin(), second.end());
+        }
+    }
+
+    // Новый элемент создаётся раньше переноса: args могут ссылаться на элементы очереди
+    template <typename... Args>
+    void ReallocateAndEmplace(bool front, Args&&... args) {
+        ArrayPtr<Type> new_items(GetCapacity() == 0 ? 1 : GetCapacity() * 2);
+        Type* slot = new_items.Get() + (front ? 0 : size_);
+        new (slot) Type(std::forward<Args>(args)...);
+        try {
+            RelocateTo(new_items.Get() + (front ? 1 : 0));
+        } catch (...) {
+            std::destroy_at(slot);
+            throw;
+        }
+        items_.swap(new_items);
+        head_ = 0;
+        ++size_;
+    }
+
+    ArrayPtr<Type> items_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+template <typename Type>
+inline bool operator==(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) return false;
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <typename Type>
+inline bool operator!=(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type>
+inline bool operator<(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type>
+inline bool operator<=(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type>
+inline bool operator>(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type>
+inline bool operator>=(const SimpleDeque<Type>& lhs, const SimpleDeque<Type>& rhs) {
+    return !(lhs < rhs);
+}
@@ -3,290 +3,608 @@
 #include <algorithm>
 #include <cassert>
 #include <initializer_list>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 #include "array_ptr.h"
+#include "bounds_check.h"
+#include "constexpr_support.h"
+#include "growth_policy.h"
+#include "relocate.h"
+#include "simd_algorithms.h"
+#include "streaming_algorithms.h"
+#include "vector_stats.h"
 
 class ReserveProxyObj {
 public:
-    explicit ReserveProxyObj(size_t capacity) : capacity_to_reserve_(capacity) {}
-    size_t GetCapacityToReserve() { return capacity_to_reserve_; }
+    SIMPLE_VECTOR_CONSTEXPR explicit ReserveProxyObj(size_t capacity) : capacity_to_reserve_(capacity) {}
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacityToReserve() { return capacity_to_reserve_; }
 
 private:
     size_t capacity_to_reserve_;
 };
 
-template <typename Type>
+// Тег для конструктора и Resize: новые элементы инициализируются по умолчанию,
+// то есть тривиальные типы (числа, POD) остаются неинициализированными
+struct DefaultInitT {
+    explicit DefaultInitT() = default;
+};
+
+inline constexpr DefaultInitT default_init{};
+
+// Буфер, отданный SimpleVector::Release: первые size из capacity элементов живы.
+// Владелец разрушает их и освобождает память через allocator.deallocate(data, capacity).
+template <typename Type, typename Allocator>
+struct ReleasedBuffer {
+    Type* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    Allocator allocator;
+};
+
+template <typename Type, typename Allocator = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth>
 class SimpleVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Stats = VectorStatsHooks<Type>;
+
+    // Аллокатор меняет размер буфера на месте (reallocate), а элементы переносятся побайтово
+    static constexpr bool kGrowsInPlace = kHasReallocate<Allocator> && is_trivially_relocatable_v<Type>;
+
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
+    using allocator_type = Allocator;
 
-    SimpleVector() noexcept = default;
+    SimpleVector() noexcept(noexcept(Allocator())) = default;
 
-    explicit SimpleVector(ReserveProxyObj reserve)
-        : size_(0),
-          capacity_(reserve.GetCapacityToReserve()),
-          items_(capacity_ > 0 ? ArrayPtr<Type>(capacity_) : ArrayPtr<Type>()) {}
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(const Allocator& alloc) noexcept
+        : items_(alloc) {}
 
-    explicit SimpleVector(size_t size)
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(ReserveProxyObj reserve, const Allocator& alloc = Allocator())
+        : items_(reserve.GetCapacityToReserve(), alloc) {}
+
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        UninitializedValueConstruct(items_.GetAllocator(), items_.Get(), items_.Get() + size);
+        size_ = size;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, DefaultInitT, const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        UninitializedDefaultConstruct(items_.GetAllocator(), items_.Get(), items_.Get() + size);
+        size_ = size;
+    }
+
+    // Принимает буфер storage, в начале которого уже живут size элементов
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(ArrayPtr<Type, Allocator>&& storage, size_t size) noexcept
         : size_(size),
-          capacity_(size),
-          items_(size > 0 ? ArrayPtr<Type>(size) : ArrayPtr<Type>()) {
-        if (size > 0) {
-            std::fill(items_.Get(), items_.Get() + size_, Type{});
-        }
+          items_(std::move(storage)) {
+        assert(size <= items_.GetSize());
     }
 
-    SimpleVector(SimpleVector&& other) noexcept
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other) noexcept
         : size_(std::exchange(other.size_, 0)),
-          capacity_(std::exchange(other.capacity_, 0)),
           items_(std::move(other.items_)) {}
 
-    SimpleVector(const SimpleVector& other)
-        : size_(other.size_),
-          capacity_(other.capacity_),
-          items_(ArrayPtr<Type>(capacity_)) {
-        std::copy(other.items_.Get(), other.items_.Get() + size_, items_.Get());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other, const Allocator& alloc)
+        : items_(alloc) {
+        if (items_.GetAllocator() == other.items_.GetAllocator()) {
+            items_.swap(other.items_);
+            size_ = std::exchange(other.size_, 0);
+        } else {
+            ArrayPtr<Type, Allocator> new_items(other.size_, alloc);
+            UninitializedMove(new_items.GetAllocator(), other.begin(), other.end(), new_items.Get());
+            items_.swap(new_items);
+            size_ = other.size_;
+        }
     }
 
-    SimpleVector(size_t size, const Type& value)
-        : size_(size),
-          capacity_(size),
-          items_(size > 0 ? ArrayPtr<Type>(size) : ArrayPtr<Type>()) {
-        for (size_t i = 0; i < size_; ++i) {
-            items_[i] = value;
-        }
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other)
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(other.items_.GetAllocator())) {}
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other, const Allocator& alloc)
+        : items_(other.GetCapacity(), alloc) {
+        UninitializedCopy(items_.GetAllocator(), other.begin(), other.end(), items_.Get());
+        size_ = other.size_;
     }
 
-    SimpleVector(std::initializer_list<Type> init)
-        : size_(init.size()),
-          capacity_(size_),
-          items_(ArrayPtr<Type>(capacity_)) {
-        std::copy(init.begin(), init.end(), items_.Get());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : items_(size, alloc) {
+        UninitializedFill(items_.GetAllocator(), items_.Get(), items_.Get() + size, value);
+        size_ = size;
     }
 
-    size_t GetSize() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : items_(init.size(), alloc) {
+        UninitializedCopy(items_.GetAllocator(), init.begin(), init.end(), items_.Get());
+        size_ = init.size();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector() {
+        DestroyRange(items_.GetAllocator(), begin(), end());
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR allocator_type GetAllocator() const noexcept {
+        return items_.GetAllocator();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
         return size_;
     }
 
-    SimpleVector& operator=(SimpleVector&& rhs) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
         if (this != &rhs) {
+            if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                          && !AllocTraits::is_always_equal::value) {
+                if (items_.GetAllocator() != rhs.items_.GetAllocator()) {
+                    // память rhs забрать нельзя: элементы переносятся поштучно
+                    SimpleVector temp(std::move(rhs), items_.GetAllocator());
+                    swap(temp);
+                    return *this;
+                }
+            }
+            Clear();
             if (rhs.IsEmpty()) {
-                Clear();
                 return *this;
             }
             items_ = std::move(rhs.items_);
             size_ = std::exchange(rhs.size_, 0);
-            capacity_ = std::exchange(rhs.capacity_, 0);
         }
         return *this;
     }
 
-    SimpleVector& operator=(const SimpleVector& rhs) {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs) {
         if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                if (items_.GetAllocator() != rhs.items_.GetAllocator()) {
+                    Clear();
+                    items_.Reset(rhs.items_.GetAllocator());
+                }
+            }
             if (rhs.IsEmpty()) {
                 Clear();
                 return *this;
             }
-            SimpleVector<Type> temp(rhs);
+            SimpleVector temp(rhs, items_.GetAllocator());
             swap(temp);
         }
         return *this;
     }
 
-    void Reserve(size_t new_capacity) {
-        if (new_capacity > capacity_) {
-            ArrayPtr<Type> new_items(new_capacity);
-            std::move(items_.Get(), items_.Get() + size_, new_items.Get());
-            items_.swap(new_items);
-            capacity_ = new_capacity;
+    // Заменяет содержимое count копиями value; value может ссылаться на элемент вектора.
+    // Буферы тривиальных элементов от kStreamingThreshold байт заполняются
+    // потоковыми записями: результат не остаётся в кеше.
+    SIMPLE_VECTOR_CONSTEXPR void Assign(size_t count, const Type& value) {
+        if constexpr (kIsStreamingAssignable<Type>) {
+            if (!IsConstantEvaluated() && count * sizeof(Type) >= kStreamingThreshold) {
+                const Type copy(value);
+                if (count > GetCapacity()) {
+                    ArrayPtr<Type, Allocator> new_items(count, items_.GetAllocator());
+                    Clear();
+                    items_.swap(new_items);
+                } else {
+                    Clear();
+                }
+                // у тривиального типа создание объектов не выполняет кода
+                UninitializedDefaultConstruct(items_.GetAllocator(), begin(), begin() + count);
+                size_ = count;
+                StreamingFill(begin(), count, copy);
+                return;
+            }
+        }
+        if (count > GetCapacity()) {
+            SimpleVector temp(count, value, items_.GetAllocator());
+            swap(temp);
+            return;
         }
+        std::fill(begin(), begin() + std::min(size_, count), value);
+        if (count > size_) {
+            UninitializedFill(items_.GetAllocator(), end(), begin() + count, value);
+        } else {
+            DestroyRange(items_.GetAllocator(), begin() + count, end());
+        }
+        size_ = count;
     }
 
-    void PushBack(const Type& item) {
-        if (size_ == capacity_) {
-            Reserve(capacity_ ? capacity_ * 2 : 1);
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            if constexpr (kGrowsInPlace) {
+                if (items_) {
+                    Stats::OnReallocation(GetCapacity(), size_);
+                    items_.Reallocate(new_capacity);
+                    return;
+                }
+            }
+            ArrayPtr<Type, Allocator> new_items(new_capacity, items_.GetAllocator());
+            Stats::OnReallocation(GetCapacity(), size_);
+            UninitializedRelocate(items_.GetAllocator(), begin(), end(), new_items.Get());
+            items_.swap(new_items);
         }
-        items_[size_] = item;
-        ++size_;
     }
 
-    void PushBack(Type&& item) {
-        if (size_ == capacity_) {
-            Reserve(capacity_ ? capacity_ * 2 : 1);
+    // Уменьшает ёмкость до размера; у пустого вектора освобождает буфер целиком
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() {
+        if (RoundCapacity<Allocator>(size_) == GetCapacity()) {
+            return;
         }
-        items_[size_] = std::move(item);
-        ++size_;
+        if constexpr (kGrowsInPlace) {
+            if (size_ != 0) {
+                Stats::OnReallocation(GetCapacity(), size_);
+                items_.Reallocate(size_);
+                return;
+            }
+        }
+        ArrayPtr<Type, Allocator> new_items(size_, items_.GetAllocator());
+        Stats::OnReallocation(GetCapacity(), size_);
+        UninitializedRelocate(items_.GetAllocator(), begin(), end(), new_items.Get());
+        items_.swap(new_items);
     }
 
-    Iterator Insert(ConstIterator pos, const Type& value) {
-        assert(pos >= begin() && pos <= end());
-        size_t index = pos - begin();
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
 
-        if (size_ == capacity_) {
-            Reserve(capacity_ ? capacity_ * 2 : 1);
-        }
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
 
-        for (size_t i = size_; i > index; --i) {
-            items_[i] = std::move(items_[i - 1]);
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(NextCapacity(size_ + 1), size_, std::forward<Args>(args)...);
+        } else {
+            AllocTraits::construct(items_.GetAllocator(), items_.Get() + size_, std::forward<Args>(args)...);
+            ++size_;
         }
+        return items_[size_ - 1];
+    }
 
-        items_[index] = value;
-        ++size_;
-        return begin() + index;
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
     }
 
-    Iterator Insert(ConstIterator pos, Type&& value) {
-        assert(pos >= begin() && pos <= end());
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
         size_t index = pos - begin();
+        // копия защищает от value, ссылающегося на элемент самого вектора
+        const Type copy(value);
+        InsertRange(index, RepeatIterator<Type>(copy, 0), count);
+        return begin() + index;
+    }
 
-        if (size_ == capacity_) {
-            Reserve(capacity_ ? capacity_ * 2 : 1);
+    // [first, last) не должен указывать на элементы самого вектора
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        DebugCheckForeignRange<Type>(first, last, cbegin(), cend());
+        size_t index = pos - begin();
+        if constexpr (kIsForwardIterator<InputIt>) {
+            InsertRange(index, first, static_cast<size_t>(std::distance(first, last)));
+        } else {
+            // длина однопроходного диапазона заранее неизвестна
+            const size_t old_size = size_;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
         }
+        return begin() + index;
+    }
 
-        for (size_t i = size_; i > index; --i) {
-            items_[i] = std::move(items_[i - 1]);
-        }
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last) {
+        Insert(end(), first, last);
+    }
 
-        items_[index] = std::move(value);
-        ++size_;
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        size_t index = pos - begin();
+
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(NextCapacity(size_ + 1), index, std::forward<Args>(args)...);
+        } else if constexpr (!kIsNothrowShiftable<Type> && std::is_copy_constructible_v<Type>) {
+            // сдвиг бросающими перемещениями не даёт строгой гарантии,
+            // поэтому вектор собирается заново в буфере той же ёмкости
+            if (index == size_) {
+                AllocTraits::construct(items_.GetAllocator(), end(), std::forward<Args>(args)...);
+                ++size_;
+            } else {
+                ReallocateAndEmplace(GetCapacity(), index, std::forward<Args>(args)...);
+            }
+        } else {
+            Stats::OnShift(size_ - index);
+            EmplaceShifting(items_.GetAllocator(), begin() + index, end(), std::forward<Args>(args)...);
+            ++size_;
+        }
         return begin() + index;
     }
 
-    void PopBack() noexcept {
-        assert(size_ > 0);
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
+        HardenedCheck(size_ > 0, "PopBack on a non-empty container");
         --size_;
+        AllocTraits::destroy(items_.GetAllocator(), items_.Get() + size_);
     }
 
-    Iterator Erase(ConstIterator pos) {
-        assert(pos >= begin() && pos <= end());
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        HardenedCheck(pos >= begin() && pos < end(), "begin <= pos < end");
         size_t index = pos - begin();
-        for (size_t i = index; i < size_ - 1; ++i) {
-            items_[i] = std::move(items_[i + 1]);
-        }
+        Stats::OnShift(size_ - index - 1);
+        EraseShifting(items_.GetAllocator(), begin() + index, begin() + index + 1, end());
         --size_;
         return begin() + index;
     }
 
-    void swap(SimpleVector& other) noexcept {
-        using std::swap;
-        swap(size_, other.size_);
-        swap(capacity_, other.capacity_);
-        swap(items_, other.items_);
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        HardenedCheck(first >= begin() && first <= last && last <= end(), "begin <= first <= last <= end");
+        size_t index = first - begin();
+        size_t count = last - first;
+        Stats::OnShift(size_ - index - count);
+        EraseShifting(items_.GetAllocator(), begin() + index, begin() + index + count, end());
+        size_ -= count;
+        return begin() + index;
+    }
+
+    // Принимает буфер без копирования: data выделен alloc под capacity элементов,
+    // первые size из них живы. Прежние элементы разрушаются, а память освобождается.
+    // Если аллокатор не распространяется при присваивании (pmr), alloc равен GetAllocator().
+    SIMPLE_VECTOR_CONSTEXPR void Adopt(Type* data, size_t size, size_t capacity, const Allocator& alloc) {
+        assert(size <= capacity && (data || capacity == 0));
+        Clear();
+        items_.Reset(data, capacity, alloc);
+        size_ = size;
     }
 
-    size_t GetCapacity() const noexcept {
-        return capacity_;
+    // data выделен аллокатором, равным GetAllocator()
+    SIMPLE_VECTOR_CONSTEXPR void Adopt(Type* data, size_t size, size_t capacity) {
+        Adopt(data, size, capacity, items_.GetAllocator());
     }
 
-    bool IsEmpty() const noexcept {
+    // Отдаёт буфер вместе с живыми элементами; вектор остаётся пустым и без памяти
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR ReleasedBuffer<Type, Allocator> Release() noexcept {
+        ReleasedBuffer<Type, Allocator> buffer{items_.Get(), size_, GetCapacity(), items_.GetAllocator()};
+        static_cast<void>(items_.Release());
+        size_ = 0;
+        return buffer;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector& other) noexcept {
+        std::swap(size_, other.size_);
+        items_.swap(other.items_);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept {
+        return items_.GetSize();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept {
         return size_ == 0;
     }
 
-    Type& operator[](size_t index) noexcept {
-        assert(index < size_);
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        HardenedCheck(index < size_, "index < size");
         return items_[index];
     }
 
-    const Type& operator[](size_t index) const noexcept {
-        assert(index < size_);
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        HardenedCheck(index < size_, "index < size");
         return items_[index];
     }
 
-    Type& At(size_t index) {
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("Index out of range");
         }
         return items_[index];
     }
 
-    const Type& At(size_t index) const {
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
         if (index >= size_) {
             throw std::out_of_range("Index out of range");
         }
         return items_[index];
     }
 
-    void Clear() noexcept {
+    // Для арифметических типов поиск и подсчёт векторизованы (см. simd_algorithms.h)
+    SIMPLE_VECTOR_CONSTEXPR Iterator Find(const Type& value) {
+        return const_cast<Iterator>(RangeFind<Type>(cbegin(), cend(), value));
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator Find(const Type& value) const {
+        return RangeFind<Type>(cbegin(), cend(), value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR bool Contains(const Type& value) const {
+        return Find(value) != cend();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR size_t Count(const Type& value) const {
+        return RangeCount<Type>(cbegin(), cend(), value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        DestroyRange(items_.GetAllocator(), begin(), end());
         size_ = 0;
     }
 
-    void Resize(size_t new_size) {
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
         if (new_size < size_) {
+            DestroyRange(items_.GetAllocator(), begin() + new_size, end());
             size_ = new_size;
         } else if (new_size > size_) {
-            if (new_size > capacity_) {
+            if (new_size > GetCapacity()) {
                 Reserve(new_size);
             }
-            for (size_t i = size_; i < new_size; ++i) {
-                items_[i] = Type();
+            UninitializedValueConstruct(items_.GetAllocator(), end(), begin() + new_size);
+            size_ = new_size;
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size, DefaultInitT) {
+        if (new_size < size_) {
+            DestroyRange(items_.GetAllocator(), begin() + new_size, end());
+            size_ = new_size;
+        } else if (new_size > size_) {
+            if (new_size > GetCapacity()) {
+                Reserve(new_size);
             }
+            UninitializedDefaultConstruct(items_.GetAllocator(), end(), begin() + new_size);
             size_ = new_size;
         }
     }
 
-    Iterator begin() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept {
         return items_.Get();
     }
 
-    Iterator end() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept {
         return items_.Get() + size_;
     }
 
-    ConstIterator begin() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept {
         return items_.Get();
     }
 
-    ConstIterator end() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
         return items_.Get() + size_;
     }
 
-    ConstIterator cbegin() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept {
         return begin();
     }
 
-    ConstIterator cend() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
         return end();
     }
 
 private:
+    SIMPLE_VECTOR_CONSTEXPR size_t NextCapacity(size_t required) const noexcept {
+        return GrowthPolicy::Grow(GetCapacity(), required, sizeof(Type));
+    }
+
+    // Создаёт элемент сразу в новом буфере, затем переносит в него остальные.
+    // Старый буфер освобождается только после успешного переноса (строгая гарантия).
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR void ReallocateAndEmplace(size_t new_capacity, size_t index, Args&&... args) {
+        if constexpr (kGrowsInPlace) {
+            if (items_ && new_capacity > GetCapacity()) {
+                // args могут ссылаться на элементы, а расширение на месте меняет адрес буфера
+                Type value(std::forward<Args>(args)...);
+                Reserve(new_capacity);
+                Stats::OnShift(size_ - index);
+                EmplaceShifting(items_.GetAllocator(), begin() + index, end(), std::move(value));
+                ++size_;
+                return;
+            }
+        }
+        ArrayPtr<Type, Allocator> new_items(new_capacity, items_.GetAllocator());
+        Stats::OnReallocation(GetCapacity(), size_);
+        RelocateAndEmplace(items_.GetAllocator(), begin(), end(), index, new_items.Get(),
+                           std::forward<Args>(args)...);
+        items_.swap(new_items);
+        ++size_;
+    }
+
+    // Вставляет count элементов из src, сдвигая хвост или перевыделяя буфер один раз
+    template <typename ForwardIt>
+    SIMPLE_VECTOR_CONSTEXPR void InsertRange(size_t index, ForwardIt src, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (count > GetCapacity() - size_) {
+            ReallocateAndInsert(NextCapacity(size_ + count), index, src, count);
+        } else if (kIsNothrowShiftable<Type> || !std::is_copy_constructible_v<Type>
+                   || index == size_) {
+            Stats::OnShift(size_ - index);
+            InsertShifting(items_.GetAllocator(), begin(), size_, index, src, count);
+        } else {
+            ReallocateAndInsert(GetCapacity(), index, src, count);
+        }
+    }
+
+    template <typename ForwardIt>
+    SIMPLE_VECTOR_CONSTEXPR void ReallocateAndInsert(size_t new_capacity, size_t index, ForwardIt src, size_t count) {
+        if constexpr (kGrowsInPlace) {
+            if (items_ && new_capacity > GetCapacity()) {
+                Reserve(new_capacity);
+                Stats::OnShift(size_ - index);
+                InsertShifting(items_.GetAllocator(), begin(), size_, index, src, count);
+                return;
+            }
+        }
+        ArrayPtr<Type, Allocator> new_items(new_capacity, items_.GetAllocator());
+        Stats::OnReallocation(GetCapacity(), size_);
+        RelocateAndInsert(items_.GetAllocator(), begin(), end(), index, new_items.Get(), src, count);
+        items_.swap(new_items);
+        size_ += count;
+    }
+
     size_t size_ = 0;
-    size_t capacity_ = 0;
-    ArrayPtr<Type> items_;
+    ArrayPtr<Type, Allocator> items_;
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+// Буфер выровнен на Alignment байт, а ёмкость кратна Alignment / sizeof(Type)
+template <typename Type, size_t Alignment = 64, typename GrowthPolicy = DoublingGrowth>
+using AlignedSimpleVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>, GrowthPolicy>;
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                        const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     if (lhs.GetSize() != rhs.GetSize()) return false;
-    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    return RangeEqual<Type>(lhs.cbegin(), rhs.cbegin(), lhs.GetSize());
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                        const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                        const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return RangeLess<Type>(lhs.cbegin(), lhs.GetSize(), rhs.cbegin(), rhs.GetSize());
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                        const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(rhs < lhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                        const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return rhs < lhs;
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs,
+                        const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !(lhs < rhs);
 }
 
-ReserveProxyObj Reserve(size_t capacity_to_reserve) {
+// Удаляет элементы, удовлетворяющие pred, за один проход; возвращает их количество
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Predicate>
+SIMPLE_VECTOR_CONSTEXPR size_t EraseIf(SimpleVector<Type, Allocator, GrowthPolicy>& vector, Predicate pred) {
+    auto new_end = std::remove_if(vector.begin(), vector.end(), pred);
+    const size_t removed = vector.end() - new_end;
+    vector.Erase(new_end, vector.end());
+    return removed;
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Value>
+SIMPLE_VECTOR_CONSTEXPR size_t Erase(SimpleVector<Type, Allocator, GrowthPolicy>& vector, const Value& value) {
+    return EraseIf(vector, [&value](const Type& item) {
+        return item == value;
+    });
+}
+
+inline SIMPLE_VECTOR_CONSTEXPR ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "bounds_check.h"
+#include "simd_algorithms.h"
+
+// Невладеющее представление непрерывного диапазона: указатель и длина.
+// Неявно строится из SimpleVector, SmallSimpleVector и других контейнеров,
+// у которых begin() возвращает указатель, поэтому функции могут принимать
+// срезы одного большого буфера без копирования. Представление действительно,
+// пока контейнер не перевыделил память.
+template <typename Type>
+class SimpleVectorView {
+    template <typename Container>
+    using RequireContiguous = std::enable_if_t<
+        !std::is_same_v<std::remove_cv_t<Container>, SimpleVectorView>
+        && std::is_convertible_v<decltype(std::declval<Container&>().begin()), Type*>
+        && std::is_convertible_v<decltype(std::declval<Container&>().GetSize()), size_t>>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    SimpleVectorView() noexcept = default;
+
+    SimpleVectorView(Type* data, size_t size) noexcept
+        : data_(data),
+          size_(size) {
+    }
+
+    // Только lvalue: представление временного контейнера сразу стало бы висячим
+    template <typename Container, typename = RequireContiguous<Container>>
+    SimpleVectorView(Container& container) noexcept
+        : data_(container.begin()),
+          size_(container.GetSize()) {
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Type& operator[](size_t index) const noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return data_[index];
+    }
+
+    Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return data_[index];
+    }
+
+    // Срез [offset, offset + count), обрезанный по концу представления
+    SimpleVectorView Subview(size_t offset, size_t count = npos) const {
+        if (offset > size_) {
+            throw std::out_of_range("Subview offset out of range");
+        }
+        return SimpleVectorView(data_ + offset, std::min(count, size_ - offset));
+    }
+
+    Iterator Find(const std::remove_const_t<Type>& value) const {
+        return const_cast<Iterator>(RangeFind<std::remove_const_t<Type>>(data_, data_ + size_, value));
+    }
+
+    bool Contains(const std::remove_const_t<Type>& value) const {
+        return Find(value) != end();
+    }
+
+    size_t Count(const std::remove_const_t<Type>& value) const {
+        return RangeCount<std::remove_const_t<Type>>(data_, data_ + size_, value);
+    }
+
+    Iterator begin() const noexcept {
+        return data_;
+    }
+
+    Iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Скрытые друзья: второй операнд может неявно преобразоваться,
+    // так что представление сравнивается и с контейнером
+    friend bool operator==(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return lhs.size_ == rhs.size_ && RangeEqual<std::remove_const_t<Type>>(lhs.data_, rhs.data_, lhs.size_);
+    }
+
+    friend bool operator!=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return RangeLess<std::remove_const_t<Type>>(lhs.data_, lhs.size_, rhs.data_, rhs.size_);
+    }
+
+    friend bool operator<=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator>=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Type>
+using ConstSimpleVectorView = SimpleVectorView<const Type>;
@@ -0,0 +1,465 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "array_ptr.h"
+#include "bounds_check.h"
+#include "growth_policy.h"
+#include "relocate.h"
+#include "simd_algorithms.h"
+#include "simple_vector.h"
+#include "vector_stats.h"
+
+// Вектор с тем же интерфейсом, что и SimpleVector, хранящий до N элементов
+// прямо в объекте. При превышении N элементы переносятся в кучу, дальше
+// ёмкость растёт так же, как у SimpleVector.
+template <typename Type, size_t N, typename GrowthPolicy = DoublingGrowth>
+class SmallSimpleVector {
+    static_assert(N > 0, "SmallSimpleVector needs room for at least one inline element");
+
+    using Allocator = std::allocator<Type>;
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Stats = VectorStatsHooks<Type>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    SmallSimpleVector() noexcept = default;
+
+    explicit SmallSimpleVector(ReserveProxyObj reserve) {
+        Reserve(reserve.GetCapacityToReserve());
+    }
+
+    explicit SmallSimpleVector(size_t size) {
+        Reserve(size);
+        UninitializedValueConstruct(GetAlloc(), begin(), begin() + size);
+        size_ = size;
+    }
+
+    SmallSimpleVector(size_t size, DefaultInitT) {
+        Reserve(size);
+        UninitializedDefaultConstruct(GetAlloc(), begin(), begin() + size);
+        size_ = size;
+    }
+
+    SmallSimpleVector(size_t size, const Type& value) {
+        Reserve(size);
+        UninitializedFill(GetAlloc(), begin(), begin() + size, value);
+        size_ = size;
+    }
+
+    SmallSimpleVector(std::initializer_list<Type> init) {
+        Reserve(init.size());
+        UninitializedCopy(GetAlloc(), init.begin(), init.end(), begin());
+        size_ = init.size();
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other) {
+        Reserve(other.size_);
+        UninitializedCopy(GetAlloc(), other.begin(), other.end(), begin());
+        size_ = other.size_;
+    }
+
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        MoveFrom(other);
+    }
+
+    ~SmallSimpleVector() {
+        DestroyRange(GetAlloc(), begin(), end());
+    }
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (this != &rhs) {
+            SmallSimpleVector temp(rhs);
+            *this = std::move(temp);
+        }
+        return *this;
+    }
+
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Clear();
+            MoveFrom(rhs);
+        }
+        return *this;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return IsInline() ? N : heap_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Элементы хранятся внутри объекта, куча не используется
+    bool IsInline() const noexcept {
+        return !heap_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            ArrayPtr<Type> new_items(new_capacity);
+            Stats::OnReallocation(GetCapacity(), size_);
+            UninitializedRelocate(GetAlloc(), begin(), end(), new_items.Get());
+            heap_.swap(new_items);
+        }
+    }
+
+    // Уменьшает ёмкость до размера; если элементы помещаются в объект,
+    // возвращает их туда и освобождает кучу
+    void ShrinkToFit() {
+        if (IsInline()) {
+            return;
+        }
+        if (size_ <= N) {
+            // ёмкость кучи сообщается до обмена: после него GetCapacity() вернёт N
+            Stats::OnReallocation(GetCapacity(), size_);
+            ArrayPtr<Type> old_items;
+            old_items.swap(heap_);
+            try {
+                UninitializedRelocate(GetAlloc(), old_items.Get(), old_items.Get() + size_, begin());
+            } catch (...) {
+                heap_.swap(old_items);
+                throw;
+            }
+        } else if (size_ < GetCapacity()) {
+            ArrayPtr<Type> new_items(size_);
+            Stats::OnReallocation(GetCapacity(), size_);
+            UninitializedRelocate(GetAlloc(), begin(), end(), new_items.Get());
+            heap_.swap(new_items);
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(NextCapacity(size_ + 1), size_, std::forward<Args>(args)...);
+        } else {
+            AllocTraits::construct(GetAlloc(), end(), std::forward<Args>(args)...);
+            ++size_;
+        }
+        return begin()[size_ - 1];
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        size_t index = pos - begin();
+        // копия защищает от value, ссылающегося на элемент самого вектора
+        const Type copy(value);
+        InsertRange(index, RepeatIterator<Type>(copy, 0), count);
+        return begin() + index;
+    }
+
+    // [first, last) не должен указывать на элементы самого вектора
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        DebugCheckForeignRange<Type>(first, last, cbegin(), cend());
+        size_t index = pos - begin();
+        if constexpr (kIsForwardIterator<InputIt>) {
+            InsertRange(index, first, static_cast<size_t>(std::distance(first, last)));
+        } else {
+            // длина однопроходного диапазона заранее неизвестна
+            const size_t old_size = size_;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+        return begin() + index;
+    }
+
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void Append(InputIt first, InputIt last) {
+        Insert(end(), first, last);
+    }
+
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        size_t index = pos - begin();
+
+        if (size_ == GetCapacity()) {
+            ReallocateAndEmplace(NextCapacity(size_ + 1), index, std::forward<Args>(args)...);
+        } else if (!kIsNothrowShiftable<Type> && std::is_copy_constructible_v<Type>
+                   && !IsInline() && index != size_) {
+            // как и SimpleVector, ради строгой гарантии собирает буфер в куче заново;
+            // внутри объекта сдвиг выполняется на месте (базовая гарантия)
+            ReallocateAndEmplace(GetCapacity(), index, std::forward<Args>(args)...);
+        } else {
+            Stats::OnShift(size_ - index);
+            EmplaceShifting(GetAlloc(), begin() + index, end(), std::forward<Args>(args)...);
+            ++size_;
+        }
+        return begin() + index;
+    }
+
+    void PopBack() noexcept {
+        HardenedCheck(size_ > 0, "PopBack on a non-empty container");
+        --size_;
+        AllocTraits::destroy(GetAlloc(), end());
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        HardenedCheck(pos >= begin() && pos < end(), "begin <= pos < end");
+        size_t index = pos - begin();
+        Stats::OnShift(size_ - index - 1);
+        EraseShifting(GetAlloc(), begin() + index, begin() + index + 1, end());
+        --size_;
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        HardenedCheck(first >= begin() && first <= last && last <= end(), "begin <= first <= last <= end");
+        size_t index = first - begin();
+        size_t count = last - first;
+        Stats::OnShift(size_ - index - count);
+        EraseShifting(GetAlloc(), begin() + index, begin() + index + count, end());
+        size_ -= count;
+        return begin() + index;
+    }
+
+    void swap(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (!IsInline() && !other.IsInline()) {
+            std::swap(size_, other.size_);
+            heap_.swap(other.heap_);
+        } else {
+            SmallSimpleVector temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+    }
+
+    Type& operator[](size_t index) noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return begin()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return begin()[index];
+    }
+
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return begin()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return begin()[index];
+    }
+
+    // Для арифметических типов поиск и подсчёт векторизованы (см. simd_algorithms.h)
+    Iterator Find(const Type& value) {
+        return const_cast<Iterator>(RangeFind<Type>(cbegin(), cend(), value));
+    }
+
+    ConstIterator Find(const Type& value) const {
+        return RangeFind<Type>(cbegin(), cend(), value);
+    }
+
+    bool Contains(const Type& value) const {
+        return Find(value) != cend();
+    }
+
+    size_t Count(const Type& value) const {
+        return RangeCount<Type>(cbegin(), cend(), value);
+    }
+
+    void Clear() noexcept {
+        DestroyRange(GetAlloc(), begin(), end());
+        size_ = 0;
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRange(GetAlloc(), begin() + new_size, end());
+            size_ = new_size;
+        } else if (new_size > size_) {
+            Reserve(new_size);
+            UninitializedValueConstruct(GetAlloc(), end(), begin() + new_size);
+            size_ = new_size;
+        }
+    }
+
+    void Resize(size_t new_size, DefaultInitT) {
+        if (new_size < size_) {
+            DestroyRange(GetAlloc(), begin() + new_size, end());
+            size_ = new_size;
+        } else if (new_size > size_) {
+            Reserve(new_size);
+            UninitializedDefaultConstruct(GetAlloc(), end(), begin() + new_size);
+            size_ = new_size;
+        }
+    }
+
+    Iterator begin() noexcept {
+        return IsInline() ? reinterpret_cast<Type*>(inline_items_) : heap_.Get();
+    }
+
+    Iterator end() noexcept {
+        return begin() + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return IsInline() ? reinterpret_cast<const Type*>(inline_items_) : heap_.Get();
+    }
+
+    ConstIterator end() const noexcept {
+        return begin() + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    Allocator& GetAlloc() noexcept {
+        return heap_.GetAllocator();
+    }
+
+    size_t NextCapacity(size_t required) const noexcept {
+        return GrowthPolicy::Grow(GetCapacity(), required, sizeof(Type));
+    }
+
+    // *this пуст; забирает буфер other из кучи или переносит его встроенные элементы
+    void MoveFrom(SmallSimpleVector& other) {
+        if (other.IsInline()) {
+            // в объекте не больше N элементов: явная граница нужна компилятору,
+            // иначе -Warray-bounds видит копирование за пределы inline_items_
+            const size_t size = std::min(other.size_, N);
+            Type* source = reinterpret_cast<Type*>(other.inline_items_);
+            UninitializedMove(GetAlloc(), source, source + size, begin());
+            size_ = size;
+            other.Clear();
+        } else {
+            heap_ = std::move(other.heap_);
+            size_ = std::exchange(other.size_, 0);
+        }
+    }
+
+    template <typename... Args>
+    void ReallocateAndEmplace(size_t new_capacity, size_t index, Args&&... args) {
+        ArrayPtr<Type> new_items(new_capacity);
+        Stats::OnReallocation(GetCapacity(), size_);
+        RelocateAndEmplace(GetAlloc(), begin(), end(), index, new_items.Get(), std::forward<Args>(args)...);
+        heap_.swap(new_items);
+        ++size_;
+    }
+
+    // Вставляет count элементов из src, сдвигая хвост или перевыделяя буфер один раз
+    template <typename ForwardIt>
+    void InsertRange(size_t index, ForwardIt src, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (count > GetCapacity() - size_) {
+            ReallocateAndInsert(NextCapacity(size_ + count), index, src, count);
+        } else if (kIsNothrowShiftable<Type> || !std::is_copy_constructible_v<Type>
+                   || index == size_ || IsInline()) {
+            Stats::OnShift(size_ - index);
+            InsertShifting(GetAlloc(), begin(), size_, index, src, count);
+        } else {
+            ReallocateAndInsert(GetCapacity(), index, src, count);
+        }
+    }
+
+    template <typename ForwardIt>
+    void ReallocateAndInsert(size_t new_capacity, size_t index, ForwardIt src, size_t count) {
+        ArrayPtr<Type> new_items(new_capacity);
+        Stats::OnReallocation(GetCapacity(), size_);
+        RelocateAndInsert(GetAlloc(), begin(), end(), index, new_items.Get(), src, count);
+        heap_.swap(new_items);
+        size_ += count;
+    }
+
+    size_t size_ = 0;
+    ArrayPtr<Type> heap_;
+    alignas(Type) unsigned char inline_items_[sizeof(Type) * N];
+};
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator==(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs,
+                        const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) return false;
+    return RangeEqual<Type>(lhs.cbegin(), rhs.cbegin(), lhs.GetSize());
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator!=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs,
+                        const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator<(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs,
+                        const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return RangeLess<Type>(lhs.cbegin(), lhs.GetSize(), rhs.cbegin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator<=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs,
+                        const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator>(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs,
+                        const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator>=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs,
+                        const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy, typename Predicate>
+size_t EraseIf(SmallSimpleVector<Type, N, GrowthPolicy>& vector, Predicate pred) {
+    auto new_end = std::remove_if(vector.begin(), vector.end(), pred);
+    const size_t removed = vector.end() - new_end;
+    vector.Erase(new_end, vector.end());
+    return removed;
+}
+
+template <typename Type, size_t N, typename GrowthPolicy, typename Value>
+size_t Erase(SmallSimpleVector<Type, N, GrowthPolicy>& vector, const Value& value) {
+    return EraseIf(vector, [&value](const Type& item) {
+        return item == value;
+    });
+}
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+#include "bounds_check.h"
+#include "growth_policy.h"
+#include "relocate.h"
+#include "simple_vector_view.h"
+
+// Структура массивов: каждое поле Ts хранится в своём непрерывном столбце,
+// а размер, ёмкость и шаг роста у столбцов общие. Цикл, которому нужны два
+// поля из девяти, читает только их столбцы, и его можно векторизовать.
+// Строка возвращается как кортеж ссылок std::tuple<Ts&...>.
+// Рост даёт строгую гарантию, как SimpleVector, кроме случая, когда у поля
+// без копирования бросающее перемещение: тогда, как и у std::vector, гарантия
+// только базовая.
+template <typename... Ts>
+class SoASimpleVector {
+    static_assert(sizeof...(Ts) > 0, "SoASimpleVector needs at least one column");
+
+    static constexpr size_t kColumnCount = sizeof...(Ts);
+    using Indices = std::index_sequence_for<Ts...>;
+    using Columns = std::tuple<ArrayPtr<Ts>...>;
+
+    template <size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    template <typename... Args>
+    using RequireRow = std::enable_if_t<sizeof...(Args) == kColumnCount>;
+
+    template <bool IsConst>
+    class BasicIterator {
+        using Owner = std::conditional_t<IsConst, const SoASimpleVector, SoASimpleVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<Ts...>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, std::tuple<const Ts&...>, std::tuple<Ts&...>>;
+        using pointer = void;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner),
+              index_(index) {
+        }
+
+        operator BasicIterator<true>() const noexcept {
+            return BasicIterator<true>(owner_, index_);
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(BasicIterator lhs, BasicIterator rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+    using Reference = std::tuple<Ts&...>;
+    using ConstReference = std::tuple<const Ts&...>;
+
+    template <size_t I>
+    using ColumnType = Field<I>;
+
+    SoASimpleVector() noexcept = default;
+
+    explicit SoASimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    SoASimpleVector(const SoASimpleVector& other) {
+        Reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            std::apply([this](const Ts&... fields) {
+                PushBack(fields...);
+            }, other[i]);
+        }
+    }
+
+    SoASimpleVector(SoASimpleVector&& other) noexcept
+        : size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          columns_(std::move(other.columns_)) {
+    }
+
+    SoASimpleVector& operator=(const SoASimpleVector& rhs) {
+        if (this != &rhs) {
+            SoASimpleVector temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    SoASimpleVector& operator=(SoASimpleVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SoASimpleVector temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~SoASimpleVector() {
+        Clear();
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Reference operator[](size_t index) noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return RowAt(index, Indices{});
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return RowAt(index, Indices{});
+    }
+
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return RowAt(index, Indices{});
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return RowAt(index, Indices{});
+    }
+
+    // Столбец I целиком: непрерывный диапазон GetSize() элементов
+    template <size_t I>
+    SimpleVectorView<ColumnType<I>> Column() noexcept {
+        return SimpleVectorView<ColumnType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    template <size_t I>
+    SimpleVectorView<const ColumnType<I>> Column() const noexcept {
+        return SimpleVectorView<const ColumnType<I>>(std::get<I>(columns_).Get(), size_);
+    }
+
+    // По одному аргументу на столбец: args[I] конструирует поле I
+    template <typename... Args, typename = RequireRow<Args...>>
+    void PushBack(Args&&... args) {
+        EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Аргументы могут ссылаться на элементы самого вектора: при росте новая
+    // строка конструируется до переноса старых
+    template <typename... Args, typename = RequireRow<Args...>>
+    Reference EmplaceBack(Args&&... args) {
+        if (size_ == capacity_) {
+            const size_t new_capacity = DoublingGrowth::Grow(capacity_, size_ + 1, kRowSize);
+            Columns new_columns{ArrayPtr<Ts>(new_capacity)...};
+            ConstructRow(new_columns, size_, Indices{}, std::forward<Args>(args)...);
+            try {
+                RelocateColumns(new_columns, Indices{});
+            } catch (...) {
+                DestroyRows(new_columns, size_, size_ + 1, Indices{});
+                throw;
+            }
+            columns_.swap(new_columns);
+            capacity_ = new_capacity;
+        } else {
+            ConstructRow(columns_, size_, Indices{}, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return RowAt(size_ - 1, Indices{});
+    }
+
+    void PopBack() noexcept {
+        HardenedCheck(size_ > 0, "PopBack on a non-empty container");
+        DestroyRows(columns_, size_ - 1, size_, Indices{});
+        --size_;
+    }
+
+    void Clear() noexcept {
+        DestroyRows(columns_, 0, size_, Indices{});
+        size_ = 0;
+    }
+
+    // Выделяет все столбцы сразу: при нехватке памяти вектор не меняется
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Columns new_columns{ArrayPtr<Ts>(new_capacity)...};
+            RelocateColumns(new_columns, Indices{});
+            columns_.swap(new_columns);
+            capacity_ = new_capacity;
+        }
+    }
+
+    // Новые строки инициализируются значением
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRows(columns_, new_size, size_, Indices{});
+            size_ = new_size;
+        } else {
+            Reserve(new_size);
+            while (size_ < new_size) {
+                EmplaceBack(Ts()...);
+            }
+        }
+    }
+
+    void swap(SoASimpleVector& other) noexcept {
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        columns_.swap(other.columns_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    static constexpr size_t kRowSize = (sizeof(Ts) + ...);
+
+    template <size_t... Is>
+    Reference RowAt(size_t index, std::index_sequence<Is...>) noexcept {
+        return Reference(std::get<Is>(columns_)[index]...);
+    }
+
+    template <size_t... Is>
+    ConstReference RowAt(size_t index, std::index_sequence<Is...>) const noexcept {
+        return ConstReference(std::get<Is>(columns_)[index]...);
+    }
+
+    // Если поле бросает исключение, уже созданные поля строки разрушаются
+    template <size_t... Is, typename... Args>
+    static void ConstructRow(Columns& columns, size_t index, std::index_sequence<Is...>, Args&&... args) {
+        size_t constructed = 0;
+        try {
+            ((new (std::get<Is>(columns).Get() + index) Field<Is>(std::forward<Args>(args)), ++constructed), ...);
+        } catch (...) {
+            ((Is < constructed ? std::destroy_at(std::get<Is>(columns).Get() + index) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... Is>
+    static void DestroyRows(Columns& columns, size_t first, size_t last, std::index_sequence<Is...>) noexcept {
+        (std::destroy(std::get<Is>(columns).Get() + first, std::get<Is>(columns).Get() + last), ...);
+    }
+
+    // Перенос поля может бросить: оно копируется, а не перемещается
+    // (поле без копирования всё же перемещается, см. RelocateColumns)
+    template <typename Type>
+    static constexpr bool kCopiesOnRelocate =
+        !is_trivially_relocatable_v<Type> && !std::is_nothrow_move_constructible_v<Type>;
+
+    // Переносит строки во все столбцы new_columns (строгая гарантия): сначала
+    // копируются столбцы, которые могут бросить, и исходники при этом не меняются,
+    // а затем без исключений переносятся остальные. Поле без копирования
+    // перемещается и здесь; если перемещение бросит, уже перемещённые элементы
+    // исходника остаются в неопределённом состоянии, и гарантия только базовая
+    template <size_t... Is>
+    void RelocateColumns(Columns& new_columns, std::index_sequence<Is...>) {
+        bool copied[kColumnCount] = {};
+        try {
+            ((copied[Is] = CopyColumn<Is>(new_columns)), ...);
+        } catch (...) {
+            ((copied[Is] ? std::destroy(std::get<Is>(new_columns).Get(), std::get<Is>(new_columns).Get() + size_)
+                         : void()),
+             ...);
+            throw;
+        }
+        (RelocateColumn<Is>(new_columns), ...);
+    }
+
+    template <size_t I>
+    bool CopyColumn(Columns& new_columns) {
+        if constexpr (kCopiesOnRelocate<Field<I>>) {
+            std::allocator<Field<I>> alloc;
+            Field<I>* first = std::get<I>(columns_).Get();
+            UninitializedMoveIfNoexcept(alloc, first, first + size_, std::get<I>(new_columns).Get());
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    template <size_t I>
+    void RelocateColumn(Columns& new_columns) noexcept {
+        std::allocator<Field<I>> alloc;
+        Field<I>* first = std::get<I>(columns_).Get();
+        if constexpr (kCopiesOnRelocate<Field<I>>) {
+            DestroyRange(alloc, first, first + size_);
+        } else {
+            UninitializedRelocate(alloc, first, first + size_, std::get<I>(new_columns).Get());
+        }
+    }
+
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    Columns columns_;
+};
+
+template <typename... Ts>
+inline bool operator==(const SoASimpleVector<Ts...>& lhs, const SoASimpleVector<Ts...>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) return false;
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+template <typename... Ts>
+inline bool operator!=(const SoASimpleVector<Ts...>& lhs, const SoASimpleVector<Ts...>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,434 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "allocator_utils.h"
+#include "bounds_check.h"
+#include "constexpr_support.h"
+#include "relocate.h"
+#include "simd_algorithms.h"
+#include "simple_vector.h"
+
+// Хранилище на Capacity элементов внутри объекта. Тривиальные элементы
+// лежат в обычном массиве: при вычислении на этапе компиляции он заполняется
+// значениями по умолчанию, чтобы результат можно было сохранить в constexpr
+// переменной, а во время выполнения остаётся неинициализированным.
+template <typename Type, size_t Capacity, bool = std::is_trivial_v<Type>>
+class StaticStorage {
+public:
+    SIMPLE_VECTOR_CONSTEXPR StaticStorage() noexcept {
+        if (IsConstantEvaluated()) {
+            for (Type& item : items_) {
+                item = Type();
+            }
+        }
+    }
+
+    StaticStorage(const StaticStorage&) = delete;
+    StaticStorage& operator=(const StaticStorage&) = delete;
+
+    constexpr Type* Data() noexcept {
+        return items_;
+    }
+
+    constexpr const Type* Data() const noexcept {
+        return items_;
+    }
+
+private:
+    Type items_[Capacity > 0 ? Capacity : 1];
+};
+
+// Нетривиальные элементы создаются и разрушаются вектором поштучно
+template <typename Type, size_t Capacity>
+class StaticStorage<Type, Capacity, false> {
+public:
+    SIMPLE_VECTOR_CONSTEXPR StaticStorage() noexcept {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ~StaticStorage() {
+    }
+
+    StaticStorage(const StaticStorage&) = delete;
+    StaticStorage& operator=(const StaticStorage&) = delete;
+
+    constexpr Type* Data() noexcept {
+        return items_;
+    }
+
+    constexpr const Type* Data() const noexcept {
+        return items_;
+    }
+
+private:
+    union {
+        Type items_[Capacity > 0 ? Capacity : 1];
+    };
+};
+
+// Вектор с ёмкостью Capacity, хранящий элементы внутри себя: память
+// не выделяется никогда, поэтому его можно использовать в ядре и в обработчиках
+// сигналов. Интерфейс повторяет SimpleVector; превышение ёмкости бросает
+// std::length_error, а TryEmplaceBack вместо этого возвращает nullptr.
+// Вставка в середину сдвигает элементы на месте: если их перемещение бросает
+// исключение, гарантия только базовая.
+template <typename Type, size_t Capacity>
+class StaticSimpleVector {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector() noexcept = default;
+
+    SIMPLE_VECTOR_CONSTEXPR explicit StaticSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector(size_t size, DefaultInitT) {
+        Resize(size, default_init);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector(size_t size, const Type& value) {
+        std::allocator<Type> alloc;
+        RequireCapacity(size);
+        UninitializedFill(alloc, begin(), begin() + size, value);
+        size_ = size;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector(std::initializer_list<Type> init) {
+        std::allocator<Type> alloc;
+        RequireCapacity(init.size());
+        UninitializedCopy(alloc, init.begin(), init.end(), begin());
+        size_ = init.size();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector(const StaticSimpleVector& other) {
+        std::allocator<Type> alloc;
+        UninitializedCopy(alloc, other.begin(), other.end(), begin());
+        size_ = other.size_;
+    }
+
+    // Элементы перемещаются поштучно, other остаётся пустым
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector(StaticSimpleVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<Type>) {
+        std::allocator<Type> alloc;
+        UninitializedMove(alloc, other.begin(), other.end(), begin());
+        size_ = other.size_;
+        other.Clear();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector& operator=(const StaticSimpleVector& rhs) {
+        if (this != &rhs) {
+            std::allocator<Type> alloc;
+            Clear();
+            UninitializedCopy(alloc, rhs.begin(), rhs.end(), begin());
+            size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector& operator=(StaticSimpleVector&& rhs) noexcept(
+        std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            std::allocator<Type> alloc;
+            Clear();
+            UninitializedMove(alloc, rhs.begin(), rhs.end(), begin());
+            size_ = rhs.size_;
+            rhs.Clear();
+        }
+        return *this;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ~StaticSimpleVector() {
+        std::allocator<Type> alloc;
+        DestroyRange(alloc, begin(), end());
+    }
+
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    static constexpr size_t GetCapacity() noexcept {
+        return Capacity;
+    }
+
+    constexpr bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr bool IsFull() const noexcept {
+        return size_ == Capacity;
+    }
+
+    // Ёмкость фиксирована: только проверяет, что new_capacity в неё помещается
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) const {
+        RequireCapacity(new_capacity);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return begin()[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        HardenedCheck(index < size_, "index < size");
+        return begin()[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return begin()[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return begin()[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Find(const Type& value) {
+        return const_cast<Iterator>(RangeFind<Type>(cbegin(), cend(), value));
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator Find(const Type& value) const {
+        return RangeFind<Type>(cbegin(), cend(), value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR bool Contains(const Type& value) const {
+        return Find(value) != cend();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR size_t Count(const Type& value) const {
+        return RangeCount<Type>(cbegin(), cend(), value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        RequireCapacity(size_ + 1);
+        return *TryEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Без исключений при переполнении: возвращает nullptr, если вектор полон
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type* TryEmplaceBack(Args&&... args) {
+        if (IsFull()) {
+            return nullptr;
+        }
+        Type* slot = ConstructAt(end(), std::forward<Args>(args)...);
+        ++size_;
+        return slot;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        const size_t index = pos - begin();
+        // копия защищает от value, ссылающегося на элемент самого вектора
+        const Type copy(value);
+        InsertRange(index, RepeatIterator<Type>(copy, 0), count);
+        return begin() + index;
+    }
+
+    // [first, last) не должен указывать на элементы самого вектора
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        DebugCheckForeignRange<Type>(first, last, cbegin(), cend());
+        const size_t index = pos - begin();
+        if constexpr (kIsForwardIterator<InputIt>) {
+            InsertRange(index, first, static_cast<size_t>(std::distance(first, last)));
+        } else {
+            const size_t old_size = size_;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+        return begin() + index;
+    }
+
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last) {
+        Insert(end(), first, last);
+    }
+
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        std::allocator<Type> alloc;
+        HardenedCheck(pos >= begin() && pos <= end(), "begin <= pos <= end");
+        const size_t index = pos - begin();
+        RequireCapacity(size_ + 1);
+        EmplaceShifting(alloc, begin() + index, end(), std::forward<Args>(args)...);
+        ++size_;
+        return begin() + index;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
+        HardenedCheck(size_ > 0, "PopBack on a non-empty container");
+        --size_;
+        std::destroy_at(end());
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        HardenedCheck(pos >= begin() && pos < end(), "begin <= pos < end");
+        return Erase(pos, pos + 1);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        std::allocator<Type> alloc;
+        HardenedCheck(first >= begin() && first <= last && last <= end(), "begin <= first <= last <= end");
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        EraseShifting(alloc, begin() + index, begin() + index + count, end());
+        size_ -= count;
+        return begin() + index;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        std::allocator<Type> alloc;
+        DestroyRange(alloc, begin(), end());
+        size_ = 0;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        std::allocator<Type> alloc;
+        if (new_size < size_) {
+            DestroyRange(alloc, begin() + new_size, end());
+        } else {
+            RequireCapacity(new_size);
+            UninitializedValueConstruct(alloc, end(), begin() + new_size);
+        }
+        size_ = new_size;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size, DefaultInitT) {
+        std::allocator<Type> alloc;
+        if (new_size < size_) {
+            DestroyRange(alloc, begin() + new_size, end());
+        } else {
+            RequireCapacity(new_size);
+            UninitializedDefaultConstruct(alloc, end(), begin() + new_size);
+        }
+        size_ = new_size;
+    }
+
+    // Обмен поэлементный: буфер нельзя передать другому объекту
+    SIMPLE_VECTOR_CONSTEXPR void swap(StaticSimpleVector& other) noexcept(
+        std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_swappable_v<Type>) {
+        if (this == &other) {
+            return;
+        }
+        std::allocator<Type> alloc;
+        StaticSimpleVector& longer = size_ >= other.size_ ? *this : other;
+        StaticSimpleVector& shorter = size_ >= other.size_ ? other : *this;
+        const size_t common = shorter.size_;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        UninitializedMove(alloc, longer.begin() + common, longer.end(), shorter.end());
+        DestroyRange(alloc, longer.begin() + common, longer.end());
+        std::swap(size_, other.size_);
+    }
+
+    constexpr Iterator begin() noexcept {
+        return storage_.Data();
+    }
+
+    constexpr Iterator end() noexcept {
+        return storage_.Data() + size_;
+    }
+
+    constexpr ConstIterator begin() const noexcept {
+        return storage_.Data();
+    }
+
+    constexpr ConstIterator end() const noexcept {
+        return storage_.Data() + size_;
+    }
+
+    constexpr ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    constexpr ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    SIMPLE_VECTOR_CONSTEXPR static void RequireCapacity(size_t required) {
+        if (required > Capacity) {
+            throw std::length_error("StaticSimpleVector capacity exceeded");
+        }
+    }
+
+    template <typename ForwardIt>
+    SIMPLE_VECTOR_CONSTEXPR void InsertRange(size_t index, ForwardIt src, size_t count) {
+        std::allocator<Type> alloc;
+        RequireCapacity(size_ + count);
+        if (count != 0) {
+            InsertShifting(alloc, begin(), size_, index, src, count);
+        }
+    }
+
+    size_t size_ = 0;
+    StaticStorage<Type, Capacity> storage_;
+};
+
+template <typename Type, size_t Capacity>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator==(const StaticSimpleVector<Type, Capacity>& lhs,
+                                               const StaticSimpleVector<Type, Capacity>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) return false;
+    return RangeEqual<Type>(lhs.cbegin(), rhs.cbegin(), lhs.GetSize());
+}
+
+template <typename Type, size_t Capacity>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator!=(const StaticSimpleVector<Type, Capacity>& lhs,
+                                               const StaticSimpleVector<Type, Capacity>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t Capacity>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator<(const StaticSimpleVector<Type, Capacity>& lhs,
+                                              const StaticSimpleVector<Type, Capacity>& rhs) {
+    return RangeLess<Type>(lhs.cbegin(), lhs.GetSize(), rhs.cbegin(), rhs.GetSize());
+}
+
+template <typename Type, size_t Capacity>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator<=(const StaticSimpleVector<Type, Capacity>& lhs,
+                                               const StaticSimpleVector<Type, Capacity>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t Capacity>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator>(const StaticSimpleVector<Type, Capacity>& lhs,
+                                              const StaticSimpleVector<Type, Capacity>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t Capacity>
+inline SIMPLE_VECTOR_CONSTEXPR bool operator>=(const StaticSimpleVector<Type, Capacity>& lhs,
+                                               const StaticSimpleVector<Type, Capacity>& rhs) {
+    return !(lhs < rhs);
+}
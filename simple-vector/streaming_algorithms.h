@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "constexpr_support.h"
+#include "simd_algorithms.h"
+
+// Заполнение и копирование больших буферов тривиально копируемых элементов
+// потоковыми записями (non-temporal stores, AVX): строки пишутся в память мимо
+// кеша, без чтения для владения (RFO) и без вытеснения рабочих данных. Источник
+// копирования подгружается программной предвыборкой (prefetch). Выигрыш есть,
+// только если буфер не будет сразу же перечитан, поэтому пути включаются только
+// явно: SimpleVector::Assign, ParallelFill, ParallelCopy и ParallelAssign, и только
+// с порога kStreamingThreshold байт. Конструирование элементов в неинициализированной
+// памяти (allocator_utils.h) их не использует.
+
+inline constexpr size_t kStreamingThreshold = size_t{16} << 20;
+
+// Запас предвыборки источника: около двух страниц впереди копирования
+inline constexpr size_t kStreamingPrefetchDistance = 1024;
+
+// Потоковые записи заменяют присваивание, поэтому тип должен его допускать
+template <typename Type>
+inline constexpr bool kIsStreamingCopyable = std::is_trivially_copyable_v<Type> && std::is_copy_assignable_v<Type>;
+
+// Заполнение шаблоном из 32 байт: размер элемента должен делить 32
+template <typename Type>
+inline constexpr bool kIsStreamingFillable = kIsStreamingCopyable<Type> && 32 % sizeof(Type) == 0;
+
+// Объекты тривиального типа создаются без выполнения кода, и затем их можно
+// записать потоком: так SimpleVector::Assign заполняет новый буфер
+template <typename Type>
+inline constexpr bool kIsStreamingAssignable = std::is_trivial_v<Type> && kIsStreamingCopyable<Type>;
+
+#ifdef SIMPLE_VECTOR_AVX2_DISPATCH
+
+// Запись 128 байт за шаг; dest и 32 байта шаблона выровнены на 32 байта
+SIMPLE_VECTOR_TARGET_AVX2 inline void Avx2StreamFill(char* dest, size_t bytes, const void* pattern_bytes) noexcept {
+    const __m256i pattern = _mm256_load_si256(static_cast<const __m256i*>(pattern_bytes));
+    char* const last = dest + bytes / 128 * 128;
+    for (; dest != last; dest += 128) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest), pattern);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 32), pattern);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 64), pattern);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 96), pattern);
+    }
+    for (const char* tail = dest + bytes % 128 / 32 * 32; dest != tail; dest += 32) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest), pattern);
+    }
+    _mm_sfence();
+}
+
+SIMPLE_VECTOR_TARGET_AVX2 inline void Avx2StreamCopy(char* dest, const char* src, size_t bytes) noexcept {
+    char* const last = dest + bytes / 128 * 128;
+    for (; dest != last; dest += 128, src += 128) {
+        _mm_prefetch(src + kStreamingPrefetchDistance, _MM_HINT_T0);
+        _mm_prefetch(src + kStreamingPrefetchDistance + 64, _MM_HINT_T0);
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 64));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest), a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 32), b);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 64), c);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 96), d);
+    }
+    _mm_sfence();
+    std::memcpy(dest, src, bytes % 128);
+}
+
+inline size_t BytesToAlignment(const void* ptr, size_t alignment) noexcept {
+    return (alignment - reinterpret_cast<uintptr_t>(ptr) % alignment) % alignment;
+}
+
+#endif
+
+// Присваивает value элементам [first, first + size), всегда потоковыми записями,
+// если процессор и тип это позволяют; порог не проверяется
+template <typename Type>
+void StreamingFill(Type* first, size_t size, const Type& value) noexcept {
+#ifdef SIMPLE_VECTOR_AVX2_DISPATCH
+    if constexpr (kIsStreamingFillable<Type>) {
+        const size_t head = BytesToAlignment(first, 32);
+        if (CpuHasAvx2() && head % sizeof(Type) == 0 && size * sizeof(Type) >= head + 32) {
+            const size_t head_size = head / sizeof(Type);
+            std::fill(first, first + head_size, value);
+            // шаблон собирается из байт: Type может не иметь конструктора по умолчанию
+            alignas(32) unsigned char pattern[32];
+            for (size_t offset = 0; offset != sizeof(pattern); offset += sizeof(Type)) {
+                std::memcpy(pattern + offset, &value, sizeof(Type));
+            }
+            const size_t bytes = (size - head_size) * sizeof(Type);
+            char* const body = reinterpret_cast<char*>(first + head_size);
+            Avx2StreamFill(body, bytes, pattern);
+            const size_t tail_size = bytes % 32 / sizeof(Type);
+            std::fill(first + size - tail_size, first + size, value);
+            return;
+        }
+    }
+#endif
+    std::fill(first, first + size, value);
+}
+
+template <typename Type>
+void StreamingCopy(const Type* src, size_t size, Type* dest) noexcept {
+    static_assert(kIsStreamingCopyable<Type>, "streaming copy needs trivially copyable, assignable elements");
+    const size_t bytes = size * sizeof(Type);
+    if (bytes == 0) {
+        return;
+    }
+#ifdef SIMPLE_VECTOR_AVX2_DISPATCH
+    if (CpuHasAvx2()) {
+        const size_t head = std::min(bytes, BytesToAlignment(dest, 32));
+        char* const out = reinterpret_cast<char*>(dest);
+        const char* const in = reinterpret_cast<const char*>(src);
+        std::memcpy(out, in, head);
+        Avx2StreamCopy(out + head, in + head, bytes - head);
+        return;
+    }
+#endif
+    std::memcpy(static_cast<void*>(dest), src, bytes);
+}
+
+// Как std::fill и std::copy над живыми элементами, но от kStreamingThreshold байт
+// потоковыми записями
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR void FillRange(Type* first, Type* last, const Type& value) {
+    if constexpr (kIsStreamingFillable<Type>) {
+        if (!IsConstantEvaluated() && static_cast<size_t>(last - first) * sizeof(Type) >= kStreamingThreshold) {
+            StreamingFill(first, static_cast<size_t>(last - first), value);
+            return;
+        }
+    }
+    std::fill(first, last, value);
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR Type* CopyRange(const Type* first, const Type* last, Type* dest) {
+    if constexpr (kIsStreamingCopyable<Type>) {
+        if (!IsConstantEvaluated() && static_cast<size_t>(last - first) * sizeof(Type) >= kStreamingThreshold) {
+            StreamingCopy(first, static_cast<size_t>(last - first), dest);
+            return dest + (last - first);
+        }
+    }
+    return std::copy(first, last, dest);
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include "constexpr_support.h"
+
+// Статистика выделений памяти контейнерами, сгруппированная по типу элемента.
+// Включается макросом SIMPLE_VECTOR_STATS; без него все хуки пустые и
+// исчезают при компиляции.
+
+#ifdef SIMPLE_VECTOR_STATS
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+inline constexpr bool kVectorStatsEnabled = true;
+
+struct VectorStatsSnapshot {
+    size_t allocations = 0;
+    size_t reallocations = 0;
+    size_t relocated_elements = 0;
+    size_t shifted_elements = 0;
+    size_t peak_capacity = 0;
+};
+
+class VectorStats {
+public:
+    void OnAllocation(size_t capacity) noexcept {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (peak < capacity && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+        }
+    }
+
+    void OnReallocation(size_t relocated) noexcept {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+        relocated_elements_.fetch_add(relocated, std::memory_order_relaxed);
+    }
+
+    void OnShift(size_t shifted) noexcept {
+        shifted_elements_.fetch_add(shifted, std::memory_order_relaxed);
+    }
+
+    VectorStatsSnapshot GetSnapshot() const noexcept {
+        VectorStatsSnapshot snapshot;
+        snapshot.allocations = allocations_.load(std::memory_order_relaxed);
+        snapshot.reallocations = reallocations_.load(std::memory_order_relaxed);
+        snapshot.relocated_elements = relocated_elements_.load(std::memory_order_relaxed);
+        snapshot.shifted_elements = shifted_elements_.load(std::memory_order_relaxed);
+        snapshot.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    void Reset() noexcept {
+        allocations_.store(0, std::memory_order_relaxed);
+        reallocations_.store(0, std::memory_order_relaxed);
+        relocated_elements_.store(0, std::memory_order_relaxed);
+        shifted_elements_.store(0, std::memory_order_relaxed);
+        peak_capacity_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<size_t> allocations_{0};
+    std::atomic<size_t> reallocations_{0};
+    std::atomic<size_t> relocated_elements_{0};
+    std::atomic<size_t> shifted_elements_{0};
+    std::atomic<size_t> peak_capacity_{0};
+};
+
+// Глобальный реестр: по одной записи VectorStats на тип элемента
+class VectorStatsRegistry {
+public:
+    static VectorStatsRegistry& Instance() {
+        static VectorStatsRegistry registry;
+        return registry;
+    }
+
+    template <typename Type>
+    static VectorStats& For() {
+        static VectorStats& stats = Instance().Register(TypeName(typeid(Type)));
+        return stats;
+    }
+
+    void Dump(std::ostream& out) const {
+        std::lock_guard lock(mutex_);
+        for (const auto& [name, stats] : stats_) {
+            const VectorStatsSnapshot snapshot = stats->GetSnapshot();
+            out << name << ": allocations=" << snapshot.allocations
+                << " reallocations=" << snapshot.reallocations
+                << " relocated=" << snapshot.relocated_elements
+                << " shifted=" << snapshot.shifted_elements
+                << " peak_capacity=" << snapshot.peak_capacity << '\n';
+        }
+    }
+
+    void Reset() {
+        std::lock_guard lock(mutex_);
+        for (auto& [name, stats] : stats_) {
+            stats->Reset();
+        }
+    }
+
+private:
+    VectorStatsRegistry() = default;
+
+    VectorStats& Register(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        auto& stats = stats_[name];
+        if (!stats) {
+            stats = std::make_unique<VectorStats>();
+        }
+        return *stats;
+    }
+
+    static std::string TypeName(const std::type_info& info) {
+#if __has_include(<cxxabi.h>)
+        int status = 0;
+        std::unique_ptr<char, void (*)(void*)> demangled(
+            abi::__cxa_demangle(info.name(), nullptr, nullptr, &status), std::free);
+        if (status == 0 && demangled) {
+            return demangled.get();
+        }
+#endif
+        return info.name();
+    }
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<VectorStats>> stats_;
+};
+
+// При вычислении на этапе компиляции статистика не собирается
+template <typename Type>
+struct VectorStatsHooks {
+    static SIMPLE_VECTOR_CONSTEXPR void OnAllocation(size_t capacity) noexcept {
+        if (!IsConstantEvaluated()) {
+            VectorStatsRegistry::For<Type>().OnAllocation(capacity);
+        }
+    }
+    // Первое выделение под пустой вектор перевыделением не считается
+    static SIMPLE_VECTOR_CONSTEXPR void OnReallocation(size_t old_capacity, size_t relocated) noexcept {
+        if (old_capacity != 0 && !IsConstantEvaluated()) {
+            VectorStatsRegistry::For<Type>().OnReallocation(relocated);
+        }
+    }
+    static SIMPLE_VECTOR_CONSTEXPR void OnShift(size_t shifted) noexcept {
+        if (!IsConstantEvaluated()) {
+            VectorStatsRegistry::For<Type>().OnShift(shifted);
+        }
+    }
+};
+
+#else
+
+inline constexpr bool kVectorStatsEnabled = false;
+
+template <typename Type>
+struct VectorStatsHooks {
+    static constexpr void OnAllocation(size_t) noexcept {}
+    static constexpr void OnReallocation(size_t, size_t) noexcept {}
+    static constexpr void OnShift(size_t) noexcept {}
+};
+
+#endif
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "simple_vector.h"
+
+// Пул потоков с собственной очередью задач у каждого рабочего потока.
+// Свои задачи поток берёт с конца очереди (LIFO, горячий кеш), а когда она
+// пуста — крадёт самые старые задачи из начала чужих очередей.
+class WorkStealingPool {
+public:
+    // Вызывающий Run поток тоже выполняет задачи, поэтому по умолчанию
+    // рабочих потоков на один меньше, чем аппаратных
+    explicit WorkStealingPool(size_t thread_count = DefaultThreadCount()) {
+        for (size_t i = 0; i < thread_count; ++i) {
+            queues_.PushBack(std::make_unique<Queue>());
+        }
+        try {
+            for (size_t i = 0; i < thread_count; ++i) {
+                workers_.EmplaceBack([this, i] {
+                    WorkerLoop(i);
+                });
+            }
+        } catch (...) {
+            Stop();
+            throw;
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        Stop();
+    }
+
+    static WorkStealingPool& Default() {
+        static WorkStealingPool pool;
+        return pool;
+    }
+
+    static size_t DefaultThreadCount() noexcept {
+        const size_t hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    size_t GetThreadCount() const noexcept {
+        return workers_.GetSize();
+    }
+
+    // Выполняет task(i) для всех i из [0, count) и ждёт их завершения.
+    // Пока задачи не готовы, вызывающий поток выполняет задачи из очередей,
+    // так что вложенные вызовы Run из задач не приводят к взаимоблокировке.
+    // Первое выброшенное задачей исключение перебрасывается после завершения остальных.
+    template <typename Task>
+    void Run(size_t count, const Task& task) {
+        if (count == 0) {
+            return;
+        }
+        if (count == 1 || workers_.IsEmpty()) {
+            for (size_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        Group group;
+        group.remaining = count;
+        for (size_t i = 0; i < count; ++i) {
+            Push([&group, &task, i] {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::lock_guard lock(group.mutex);
+                    if (!group.error) {
+                        group.error = std::current_exception();
+                    }
+                }
+                // group живёт на стеке Run: после уменьшения счётчика её трогать нельзя,
+                // поэтому уведомление выполняется под тем же мьютексом
+                std::lock_guard lock(group.mutex);
+                if (--group.remaining == 0) {
+                    group.done.notify_all();
+                }
+            });
+        }
+
+        while (group.remaining.load() != 0) {
+            if (!TryRunOne()) {
+                std::unique_lock lock(group.mutex);
+                group.done.wait(lock, [&group] {
+                    return group.remaining.load() == 0;
+                });
+            }
+        }
+        std::lock_guard lock(group.mutex);
+        if (group.error) {
+            std::rethrow_exception(group.error);
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    struct Group {
+        std::atomic<size_t> remaining{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    // Рабочий поток кладёт задачи в свою очередь, внешний — по кругу во все
+    void Push(std::function<void()> task) {
+        const size_t index = CurrentPool() == this ? CurrentIndex()
+                                                   : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.GetSize();
+        {
+            std::lock_guard lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        pending_.fetch_add(1);
+        {
+            // пустой захват не даёт потоку пропустить уведомление между проверкой и ожиданием
+            std::lock_guard lock(sleep_mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    bool TryRunOne() {
+        std::function<void()> task;
+        const bool is_worker = CurrentPool() == this;
+        const size_t self = is_worker ? CurrentIndex() : 0;
+        if (is_worker) {
+            Queue& own = *queues_[self];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        for (size_t offset = is_worker ? 1 : 0; !task && offset < queues_.GetSize(); ++offset) {
+            Queue& victim = *queues_[(self + offset) % queues_.GetSize()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+        if (!task) {
+            return false;
+        }
+        pending_.fetch_sub(1);
+        task();
+        return true;
+    }
+
+    void WorkerLoop(size_t index) {
+        CurrentPool() = this;
+        CurrentIndex() = index;
+        while (true) {
+            if (TryRunOne()) {
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            wake_.wait(lock, [this] {
+                return stop_ || pending_.load() != 0;
+            });
+            if (stop_ && pending_.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    void Stop() noexcept {
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+        workers_.Clear();
+    }
+
+    static const WorkStealingPool*& CurrentPool() noexcept {
+        thread_local const WorkStealingPool* pool = nullptr;
+        return pool;
+    }
+
+    static size_t& CurrentIndex() noexcept {
+        thread_local size_t index = 0;
+        return index;
+    }
+
+    SimpleVector<std::unique_ptr<Queue>> queues_;
+    SimpleVector<std::thread> workers_;
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<size_t> pending_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+};